@@ -0,0 +1,186 @@
+// (c) Copyright 2026 Aaron Kimball
+// This library is licensed under the terms of the BSD 3-Clause license.
+// See the accompanying LICENSE.txt file for full license text.
+//
+// Host-side implementation of the Arduino core subset declared in Arduino.h.
+
+#include <Arduino.h>
+#include <thread>
+#include <vector>
+
+#include "SimBoard.h"
+#include "SimBus.h"
+
+namespace {
+
+struct PinState {
+  uint8_t mode = INPUT;
+  uint8_t outLevel = LOW;
+  uint8_t lineLevel = HIGH; // Last computed level of an INT line.
+  SimGpio::PinListener listener;
+  SimGpio::InputSource source;
+  std::vector<SimDevice*> intDevices;
+  void (*isr)() = nullptr;
+  int isrMode = 0;
+  bool isrPending = false;
+};
+
+uint64_t gNowNanos = 0;
+PinState gPins[SimGpio::NUM_PINS];
+bool gInterruptsEnabled = true;
+bool gInRefresh = false;
+
+void runPendingIsrs() {
+  for (PinState& p : gPins) {
+    if (p.isrPending && p.isr != nullptr) {
+      p.isrPending = false;
+      p.isr();
+    }
+  }
+}
+
+} // namespace
+
+uint64_t SimClock::nowNanos() { return gNowNanos; }
+
+void SimClock::advanceNanos(uint64_t nanos) { gNowNanos += nanos; }
+
+void SimClock::reset() { gNowNanos = 0; }
+
+void SimGpio::setListener(uint8_t pin, PinListener listener) {
+  if (pin < NUM_PINS) {
+    gPins[pin].listener = listener;
+  }
+}
+
+void SimGpio::setInputSource(uint8_t pin, InputSource source) {
+  if (pin < NUM_PINS) {
+    gPins[pin].source = source;
+  }
+}
+
+void SimGpio::connectInt(uint8_t pin, SimDevice* dev) {
+  if (pin < NUM_PINS) {
+    gPins[pin].intDevices.push_back(dev);
+  }
+  refresh();
+}
+
+void SimGpio::refresh() {
+  if (gInRefresh) {
+    return;
+  }
+  gInRefresh = true;
+  for (PinState& p : gPins) {
+    if (p.intDevices.empty()) {
+      continue;
+    }
+    uint8_t level = HIGH;
+    for (SimDevice* dev : p.intDevices) {
+      if (dev->intAsserted()) {
+        level = LOW;
+      }
+    }
+    uint8_t prev = p.lineLevel;
+    p.lineLevel = level;
+    if (p.isr == nullptr || prev == level) {
+      continue;
+    }
+    if (p.isrMode == CHANGE || (p.isrMode == FALLING && level == LOW)
+        || (p.isrMode == RISING && level == HIGH)) {
+      p.isrPending = true;
+    }
+  }
+  gInRefresh = false;
+  if (gInterruptsEnabled) {
+    runPendingIsrs();
+  }
+}
+
+uint8_t SimGpio::read(uint8_t pin) {
+  if (pin >= NUM_PINS) {
+    return LOW;
+  }
+  const PinState& p = gPins[pin];
+  if (!p.intDevices.empty()) {
+    return p.lineLevel;
+  }
+  if (p.mode == OUTPUT) {
+    return p.outLevel;
+  }
+  if (p.source) {
+    return p.source();
+  }
+  return p.mode == INPUT_PULLUP ? HIGH : LOW;
+}
+
+void SimGpio::write(uint8_t pin, uint8_t level) {
+  if (pin >= NUM_PINS) {
+    return;
+  }
+  PinState& p = gPins[pin];
+  p.outLevel = level ? HIGH : LOW;
+  // A pin that is not an output does not drive the line.
+  if (p.listener && p.mode == OUTPUT) {
+    p.listener(p.outLevel);
+  }
+}
+
+void SimGpio::setMode(uint8_t pin, uint8_t mode) {
+  if (pin < NUM_PINS) {
+    gPins[pin].mode = mode;
+  }
+}
+
+void SimGpio::attach(uint8_t pin, void (*isr)(), int mode) {
+  if (pin < NUM_PINS) {
+    gPins[pin].isr = isr;
+    gPins[pin].isrMode = mode;
+    gPins[pin].isrPending = false;
+  }
+}
+
+void SimGpio::detach(uint8_t pin) {
+  if (pin < NUM_PINS) {
+    gPins[pin].isr = nullptr;
+    gPins[pin].isrPending = false;
+  }
+}
+
+void SimGpio::reset() {
+  for (PinState& p : gPins) {
+    p = PinState();
+  }
+  gInterruptsEnabled = true;
+}
+
+void pinMode(uint8_t pin, uint8_t mode) { SimGpio::setMode(pin, mode); }
+
+void digitalWrite(uint8_t pin, uint8_t val) { SimGpio::write(pin, val); }
+
+int digitalRead(uint8_t pin) { return SimGpio::read(pin); }
+
+void attachInterrupt(int irq, void (*isr)(), int mode) {
+  SimGpio::attach(static_cast<uint8_t>(irq), isr, mode);
+}
+
+void detachInterrupt(int irq) { SimGpio::detach(static_cast<uint8_t>(irq)); }
+
+void noInterrupts() { gInterruptsEnabled = false; }
+
+void interrupts() {
+  gInterruptsEnabled = true;
+  runPendingIsrs();
+}
+
+void delay(unsigned long ms) { SimClock::advanceNanos(static_cast<uint64_t>(ms) * 1000000ULL); }
+
+void delayMicroseconds(unsigned int us) { SimClock::advanceNanos(static_cast<uint64_t>(us) * 1000ULL); }
+
+void delayNanoseconds(uint32_t nsec) { SimClock::advanceNanos(nsec); }
+
+unsigned long millis() { return static_cast<unsigned long>(SimClock::nowNanos() / 1000000ULL); }
+
+unsigned long micros() { return static_cast<unsigned long>(SimClock::nowNanos() / 1000ULL); }
+
+void yield() { std::this_thread::yield(); }
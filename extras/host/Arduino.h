@@ -0,0 +1,53 @@
+// (c) Copyright 2026 Aaron Kimball
+// This library is licensed under the terms of the BSD 3-Clause license.
+// See the accompanying LICENSE.txt file for full license text.
+//
+// Host-side stand-in for the Arduino core API. This provides only the subset of
+// <Arduino.h> used by I2CParallel2, backed by a simulated clock and GPIO block
+// (see SimBoard.h) so the library can be compiled and exercised on Linux.
+
+#ifndef I2C_PARALLEL_HOST_ARDUINO_H
+#define I2C_PARALLEL_HOST_ARDUINO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT        0x0
+#define OUTPUT       0x1
+#define INPUT_PULLUP 0x2
+
+#define CHANGE  1
+#define FALLING 2
+#define RISING  3
+
+#define ARDUINO_HOST_SIM 1
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+
+inline int digitalPinToInterrupt(uint8_t pin) { return pin; }
+void attachInterrupt(int irq, void (*isr)(), int mode);
+void detachInterrupt(int irq);
+void noInterrupts();
+void interrupts();
+
+// Time only moves forward when the simulated bus is clocked or when one of the
+// delay functions is called.
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void delayNanoseconds(uint32_t nsec);
+unsigned long millis();
+unsigned long micros();
+
+// Lets another host thread run (the benchmarks use std::thread for "cores").
+void yield();
+
+#endif /* I2C_PARALLEL_HOST_ARDUINO_H */
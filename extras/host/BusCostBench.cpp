@@ -0,0 +1,1371 @@
+// (c) Copyright 2026 Aaron Kimball
+// This library is licensed under the terms of the BSD 3-Clause license.
+// See the accompanying LICENSE.txt file for full license text.
+//
+// Bus-cost benchmark: runs each public I2CParallel2 operation against the
+// simulated bus and reports what it put on the wire. Bus time is modeled from
+// the SCL bit periods used, so the result at each clock rate is exact for the
+// model and independent of host speed.
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#include "I2CParallel2.h"
+#include "I2CParallelAsync.h"
+#include "I2CParallelBank.h"
+#include "I2CParallelDebounce.h"
+#include "I2CParallelDiscovery.h"
+#include "I2CParallelEvents.h"
+#include "I2CParallelMatrix.h"
+#include "I2CParallelPins.h"
+#include "I2CParallelScheduler.h"
+#include "I2CParallelShared.h"
+#include "I2CParallelT.h"
+#include "I2CParallelWaveform.h"
+#include "SimBoard.h"
+#include "SimDevices.h"
+
+static constexpr uint8_t ADDR_8574 = 0x20;
+static constexpr uint8_t ADDR_9534 = 0x38;
+static constexpr uint8_t ADDR_9538 = 0x70;
+static constexpr uint8_t RESET_PIN_9538 = 5;
+static constexpr uint8_t ADDR_TCAL6408 = 0x21;
+static constexpr uint8_t RESET_PIN_TCAL6408 = 6;
+
+static int gFailures = 0;
+
+// Record a correctness check. Any failed check makes the bench exit non-zero.
+static void check(const bool ok, const char* what) {
+  if (!ok) {
+    printf("FAIL   %s\n", what);
+    gFailures++;
+  }
+}
+
+static void printHeader() {
+  printf("%-6s %-24s %5s %5s %5s %5s %5s %10s %10s\n", "device", "operation", "START", "rSTRT",
+      "STOP", "bytes", "bits", "us@100kHz", "us@400kHz");
+}
+
+// Run `fn`, print the bus traffic it caused, and return the counters.
+template <typename Fn>
+static SimBusCounters measure(const char* device, const char* op, Fn fn) {
+  SimBus& bus = Wire.bus();
+  bus.resetCounters();
+  fn();
+  const SimBusCounters& c = bus.counters();
+  printf("%-6s %-24s %5u %5u %5u %5u %5llu %10.1f %10.1f\n", device, op, c.starts,
+      c.repeatedStarts, c.stops, c.totalBytes(), static_cast<unsigned long long>(c.bitTimes),
+      c.microsAt(I2C_SPEED_STANDARD), c.microsAt(I2C_SPEED_FAST));
+  return c;
+}
+
+// Return true if the counters show no bus activity at all.
+static bool isIdle(const SimBusCounters& c) {
+  return c.starts == 0 && c.bitTimes == 0;
+}
+
+// Command bytes the device needs in front of the data of each transaction.
+static uint8_t simCommandBytes(const SimPCF8574& sim) {
+  return 0;
+}
+static uint8_t simCommandBytes(const SimPCA9534& sim) {
+  return 1;
+}
+
+// The value the device is driving onto its output pins.
+static uint8_t simOutput(const SimPCF8574& sim) {
+  return sim.latch();
+}
+static uint8_t simOutput(const SimPCA9534& sim) {
+  return sim.outputReg();
+}
+
+// Operations common to every I2CParallel implementation; `sim` models `dev`.
+template <typename Sim>
+static void benchCommon(const char* name, I2CParallel& dev, Sim& sim) {
+  measure(name, "setByte", [&] { dev.setByte(0x5A); });
+  check(isIdle(measure(name, "setByte (same)", [&] { dev.setByte(0x5A); })),
+      "setByte (same) is elided");
+  measure(name, "getByte", [&] { dev.getByte(); });
+  measure(name, "setBit", [&] { dev.setBit(0); });
+  measure(name, "clrBit", [&] { dev.clrBit(0); });
+  measure(name, "toggleBit", [&] { dev.toggleBit(1); });
+  measure(name, "setOr/setAnd/setXor", [&] {
+    dev.setOr(0x01);
+    dev.setAnd(0xFE);
+    dev.setXor(0x0F);
+  });
+  measure(name, "increment", [&] { dev.increment(); });
+  measure(name, "enableInputs", [&] { dev.enableInputs(0xF0); });
+  const SimBusCounters reads = measure(name, "getByte x8", [&] {
+    for (int i = 0; i < 8; i++) {
+      dev.getByte();
+    }
+  });
+  // The '9534 register pointer stays parked on INPUT after the first read.
+  check(reads.starts == 8u + simCommandBytes(sim), "getByte x8 sends one command byte at most");
+  uint8_t waveform[64];
+  for (size_t i = 0; i < sizeof(waveform); i++) {
+    waveform[i] = static_cast<uint8_t>(i * 2 + 1); // No two consecutive values alike.
+  }
+  measure(name, "setByte x64", [&] {
+    for (uint8_t val : waveform) {
+      dev.setByte(val);
+    }
+  });
+  const SimBusCounters burst =
+      measure(name, "setBytes(64)", [&] { dev.setBytes(waveform, sizeof(waveform)); });
+  // One transaction per TX buffer's worth of data bytes after the command byte.
+  const uint32_t perChunk = BUFFER_LENGTH - simCommandBytes(sim);
+  check(burst.starts == (sizeof(waveform) + perChunk - 1) / perChunk,
+      "setBytes(64) uses one transaction per TX buffer");
+  check(simOutput(sim) == waveform[sizeof(waveform) - 1]
+          && dev.getLastOutputState() == waveform[sizeof(waveform) - 1],
+      "setBytes(64) leaves the last value latched");
+  uint8_t samples[64];
+  measure(name, "getByte x64", [&] {
+    for (uint8_t& sample : samples) {
+      sample = dev.getByte();
+    }
+  });
+  uint32_t stamps[sizeof(samples)];
+  measure(name, "captureBytes(64)", [&] { dev.captureBytes(samples, sizeof(samples), stamps); });
+  bool stampsIncrease = true;
+  for (size_t i = 1; i < sizeof(samples); i++) {
+    stampsIncrease = stampsIncrease && stamps[i] > stamps[i - 1];
+  }
+  check(stampsIncrease, "captureBytes(64) timestamps increase");
+  dev.setByte(0xF0);
+  measure(name, "setBit x4 (4 pins)", [&] {
+    for (uint8_t i = 0; i < 4; i++) {
+      dev.setBit(i);
+    }
+  });
+  const SimBusCounters batch = measure(name, "clrBit x4 batched", [&] {
+    I2CParallelUpdate update(dev);
+    for (uint8_t i = 0; i < 4; i++) {
+      dev.clrBit(i);
+    }
+  });
+  check(batch.starts == 1 && simOutput(sim) == 0xF0, "clrBit x4 batched is one write");
+  const SimBusCounters noop = measure(name, "toggleBit x2 batched", [&] {
+    I2CParallelUpdate update(dev);
+    dev.toggleBit(6);
+    dev.toggleBit(6);
+  });
+  check(isIdle(noop), "toggleBit x2 batched writes nothing");
+}
+
+static void bench9534(const char* name, I2CParallel9534& dev, SimPCA9534& sim) {
+  benchCommon(name, dev, sim);
+  measure(name, "setInputPolarity", [&] { dev.setInputPolarity(0x0F); });
+  check(isIdle(measure(name, "setInputPolarity (same)", [&] { dev.setInputPolarity(0x0F); })),
+      "setInputPolarity (same) is elided");
+  check(isIdle(measure(name, "enableInputs (same)", [&] { dev.enableInputs(0xF0); })),
+      "enableInputs (same) is elided");
+  measure(name, "resync", [&] { dev.resync(); });
+  I2CParallel& base = dev;
+  dev.setIntPinMode(I2C_PARALLEL_INT_CONNECTED);
+  measure(name, "getByte x8 (INT errata)", [&] {
+    for (int i = 0; i < 8; i++) {
+      base.getByte();
+    }
+  });
+  dev.setIntPinMode(I2C_PARALLEL_INT_AUTO);
+}
+
+// A bank of 8 PCF8574 + 8 PCF8574A devices driven as one 128-pin port.
+static void benchBank() {
+  static constexpr uint8_t NUM_DEVICES = 16;
+  SimPCF8574* sims[NUM_DEVICES];
+  I2CParallel8574 devs[NUM_DEVICES];
+  I2CParallel* ptrs[NUM_DEVICES];
+
+  Wire.bus().detachAll();
+  for (uint8_t i = 0; i < NUM_DEVICES; i++) {
+    const uint8_t addr = (i < 8) ? I2C_PCF8574_MIN_ADDR + i : I2C_PCF8574A_MIN_ADDR + i - 8;
+    sims[i] = new SimPCF8574(addr);
+    Wire.bus().attach(sims[i]);
+    devs[i].init(addr);
+    ptrs[i] = &devs[i];
+  }
+
+  I2CParallelBank bank(ptrs, NUM_DEVICES);
+  uint8_t vals[NUM_DEVICES];
+  for (uint8_t i = 0; i < NUM_DEVICES; i++) {
+    vals[i] = i;
+  }
+  measure("bank16", "flush (all 16 changed)", [&] {
+    bank.writeAll(vals);
+    bank.flush();
+  });
+  printf("%-6s %-24s skew %u us, flush %u us\n", "bank16", "", bank.getLastFlushSkewMicros(),
+      bank.getLastFlushMicros());
+  measure("bank16", "flush (2 pins changed)", [&] {
+    bank.togglePin(3);
+    bank.togglePin(127);
+    bank.flush();
+  });
+  printf("%-6s %-24s skew %u us, flush %u us\n", "bank16", "", bank.getLastFlushSkewMicros(),
+      bank.getLastFlushMicros());
+  measure("bank16", "flush (no change)", [&] { bank.flush(); });
+  measure("bank16", "readInputs", [&] { bank.readInputs(); });
+
+  // One of the two dirty devices drops off the bus.
+  Wire.bus().detach(sims[NUM_DEVICES - 1]);
+  bank.togglePin(3);
+  bank.togglePin(127);
+  const uint8_t numWritten = bank.flush();
+  printf("%-6s %-24s wrote %u of 2, skew %u us, dirty=%d\n", "bank16", "flush (1 device absent)",
+      numWritten, bank.getLastFlushSkewMicros(), bank.isDirty());
+  check(numWritten == 1 && bank.getLastFlushSkewMicros() == 0 && bank.isDirty(),
+      "bank flush counts only successful writes");
+  devs[NUM_DEVICES - 1].clearError();
+
+  Wire.bus().detachAll();
+  for (SimPCF8574* sim : sims) {
+    delete sim;
+  }
+}
+
+// Watching 4 input pins for 1000 loop iterations, with 2 pin changes: busy
+// polling vs the interrupt-driven event pipeline.
+static void benchEvents() {
+  static constexpr uint8_t INT_PIN = 2;
+  static constexpr int NUM_LOOPS = 1000;
+  SimPCA9534 sim(ADDR_9534);
+  Wire.bus().attach(&sim);
+  SimGpio::connectInt(INT_PIN, &sim);
+
+  I2CParallel9534 dev;
+  dev.init(ADDR_9534);
+  dev.enableInputs(0x0F);
+  I2CParallel& base = dev;
+
+  measure("events", "poll getByte x1000", [&] {
+    for (int i = 0; i < NUM_LOOPS; i++) {
+      if (i == 100 || i == 600) {
+        sim.setInputs(sim.pins() ^ 0x01);
+      }
+      base.getByte();
+    }
+  });
+
+  I2CParallelEvents events(dev);
+  events.begin(INT_PIN);
+  base.getByte(); // Prime the last-known input state.
+  int numEvents = 0;
+  measure("events", "service() x1000", [&] {
+    for (int i = 0; i < NUM_LOOPS; i++) {
+      if (i == 100 || i == 600) {
+        sim.setInputs(sim.pins() ^ 0x01);
+      }
+      numEvents += events.service();
+    }
+  });
+  printf("%-6s %-24s %d events\n", "events", "", numEvents);
+  check(numEvents == 2, "events: one event per input change");
+
+  // Another reader of the device must not swallow the edge.
+  I2CParallelEvent event = { 0, 0, false };
+  while (events.popEvent(event)) {
+  }
+  sim.setInputs(sim.pins() ^ 0x02);
+  const bool rising = (sim.pins() & 0x02) != 0;
+  base.getByte();
+  check(events.service(true) == 1 && events.popEvent(event) && event.pin == 1
+          && event.rising == rising,
+      "events: edge survives another getByte()");
+
+  Wire.bus().detachAll();
+  SimGpio::reset();
+}
+
+// Four expanders sharing one INT_L line. Each interrupt comes from one device;
+// the dispatcher reads in priority order and stops once the line is released,
+// vs. reading every device on every interrupt.
+static void benchDispatch() {
+  static constexpr uint8_t INT_PIN = 3;
+  static constexpr int NUM_INTERRUPTS = 100;
+  SimPCF8574 simA(0x20);
+  SimPCF8574 simB(0x21);
+  SimPCA9534 simC(0x38);
+  SimPCA9534 simD(0x39);
+  SimDevice* sims[] = { &simA, &simB, &simC, &simD };
+  for (SimDevice* sim : sims) {
+    Wire.bus().attach(sim);
+    SimGpio::connectInt(INT_PIN, sim);
+  }
+  I2CParallel8574 devA;
+  I2CParallel8574 devB;
+  I2CParallel9534 devC;
+  I2CParallel9534 devD;
+  devA.init(0x20);
+  devB.init(0x21);
+  devC.init(0x38);
+  devD.init(0x39);
+  devC.enableInputs(0xFF);
+  devD.enableInputs(0xFF);
+
+  I2CParallelEvents eventsA(devA);
+  I2CParallelEvents eventsB(devB);
+  I2CParallelEvents eventsC(devC);
+  I2CParallelEvents eventsD(devD);
+  I2CParallelEvents* all[] = { &eventsA, &eventsB, &eventsC, &eventsD };
+  for (I2CParallelEvents* events : all) {
+    events->service(true); // Prime the last-known input state.
+  }
+
+  // Interrupt sources: 70% device A, 20% B, 10% C; D stays quiet.
+  auto toggleSource = [&](int i) {
+    const int k = i % 10;
+    if (k < 7) {
+      simA.setInputs(simA.pins() ^ 0x01);
+    } else if (k < 9) {
+      simB.setInputs(simB.pins() ^ 0x02);
+    } else {
+      simC.setInputs(simC.pins() ^ 0x04);
+    }
+  };
+
+  int numEvents = 0;
+  measure("intdsp", "read all x100", [&] {
+    for (int i = 0; i < NUM_INTERRUPTS; i++) {
+      toggleSource(i);
+      for (I2CParallelEvents* events : all) {
+        numEvents += events->service(true);
+      }
+    }
+  });
+  printf("%-6s %-24s %d events, 4.00 reads/interrupt\n", "intdsp", "", numEvents);
+  check(numEvents == NUM_INTERRUPTS, "intdsp: reading every device finds each event");
+
+  I2CParallelIntDispatcher dispatcher(INT_PIN);
+  dispatcher.add(eventsD, 3);
+  dispatcher.add(eventsC, 2);
+  dispatcher.add(eventsA, 0);
+  dispatcher.add(eventsB, 1);
+  dispatcher.begin();
+  numEvents = 0;
+  int numReads = 0;
+  measure("intdsp", "dispatcher x100", [&] {
+    for (int i = 0; i < NUM_INTERRUPTS; i++) {
+      toggleSource(i);
+      numEvents += dispatcher.service();
+      numReads += dispatcher.getLastReadCount();
+    }
+  });
+  printf("%-6s %-24s %d events, %.2f reads/interrupt, line %s\n", "intdsp", "", numEvents,
+      (double)numReads / NUM_INTERRUPTS, digitalRead(INT_PIN) == HIGH ? "released" : "held");
+  check(numEvents == NUM_INTERRUPTS, "intdsp: the dispatcher finds each event");
+  // Priority order A, B, C: 70 interrupts take 1 read, 20 take 2 and 10 take 3.
+  check(numReads == 70 * 1 + 20 * 2 + 10 * 3, "intdsp: the dispatcher makes 1.40 reads/interrupt");
+  check(digitalRead(INT_PIN) == HIGH, "intdsp: the dispatcher leaves INT_L released");
+
+  Wire.bus().detachAll();
+  SimGpio::reset();
+}
+
+// Two buttons (active-low) on a '8574 and a '9534, sampled every 5 ms. Each
+// press and release bounces for 3 samples; the debounced state changes once.
+static void benchDebounce() {
+  static constexpr int NUM_SAMPLES = 60;
+  SimPCF8574 sim8574(ADDR_8574);
+  SimPCA9534 sim9534(ADDR_9534);
+  Wire.bus().attach(&sim8574);
+  Wire.bus().attach(&sim9534);
+  I2CParallel8574 dev8574;
+  I2CParallel9534 dev9534;
+  dev8574.init(ADDR_8574);
+  dev9534.init(ADDR_9534);
+  dev8574.enableInputs(0xFF);
+  dev9534.enableInputs(0xFF);
+  sim9534.setInputs(0xFF);
+  I2CParallel* devices[] = { &dev8574, &dev9534 };
+  static_cast<I2CParallel&>(dev8574).getByte();
+  static_cast<I2CParallel&>(dev9534).getByte();
+
+  // Button level at sample i: pressed for samples 10--39, bouncing on each edge.
+  auto level = [](int i, int offset) -> uint8_t {
+    i -= offset;
+    const bool pressed = i >= 10 && i < 40;
+    const bool bouncing = (i >= 10 && i < 13) || (i >= 40 && i < 43);
+    return (bouncing ? (i & 1) : !pressed) ? 0xFF : 0xFE;
+  };
+
+  I2CParallelDebounce debounce(devices, 2, 4);
+  int rawEdges = 0;
+  int presses = 0;
+  int releases = 0;
+  uint8_t lastRaw = 0xFF;
+  measure("dbnc", "sample() x60 (2 devices)", [&] {
+    for (int i = 0; i < NUM_SAMPLES; i++) {
+      sim8574.setInputs(level(i, 0));
+      sim9534.setInputs(level(i, 5));
+      debounce.sample();
+      rawEdges += __builtin_popcount((dev8574.getLastInputState() ^ lastRaw) & 0x01);
+      lastRaw = dev8574.getLastInputState();
+      for (uint8_t d = 0; d < debounce.size(); d++) {
+        presses += __builtin_popcount(debounce.getPressed(d));
+        releases += __builtin_popcount(debounce.getReleased(d));
+      }
+      delay(5);
+    }
+  });
+  printf("%-6s %-24s 8574 raw edges=%d; debounced presses=%d releases=%d (both devices)\n",
+      "dbnc", "", rawEdges, presses, releases);
+
+  // 16 packed lanes, all 128 pins bouncing at once: one update() per sample.
+  I2CParallelDebounce wide(16, 4);
+  uint8_t samples[16];
+  int wideEdges = 0;
+  for (int i = 0; i < NUM_SAMPLES; i++) {
+    for (uint8_t d = 0; d < 16; d++) {
+      samples[d] = level(i, d / 2) == 0xFF ? 0xFF : 0x00;
+    }
+    wide.update(samples);
+    for (uint8_t d = 0; d < 16; d++) {
+      wideEdges += __builtin_popcount(wide.getPressed(d)) + __builtin_popcount(wide.getReleased(d));
+    }
+  }
+  printf("%-6s %-24s 128 pins: %d debounced edges (expect 256)\n", "dbnc", "update() x60",
+      wideEdges);
+  check(wideEdges == 256, "wide debounce reports every edge once");
+
+  // Lanes without a device take no sample, so sample() must clear the edges
+  // left by the last update().
+  I2CParallelDebounce unbound(2, 1);
+  const uint8_t pressed[2] = { 0x00, 0x00 };
+  unbound.update(pressed);
+  unbound.sample();
+  check(unbound.getPressed(0) == 0 && unbound.getPressed(1) == 0,
+      "debounce sample() clears the edges of lanes without a device");
+  unbound.update(samples);
+  unbound.useLastInputs();
+  check(unbound.getReleased(0) == 0 && unbound.getReleased(1) == 0,
+      "debounce useLastInputs() clears the edges of lanes without a device");
+
+  Wire.bus().detachAll();
+}
+
+// A 4x4 key matrix (rows on pins 0--3, columns on pins 4--7) on a '8574 and a
+// '9534: a full scan as one setByte() + getByte() per row vs. scanRows(); then
+// three keys at the corners of a rectangle, which ghost the fourth.
+static void benchMatrix() {
+  static constexpr uint8_t ROWS = 0x0F;
+  static constexpr uint8_t COLS = 0xF0;
+  bool keys[4][4] = {};
+  // Pressed keys join their row and column nets; any net joined to a row
+  // driven low reads low.
+  auto matrix = [&keys](uint8_t levels) -> uint8_t {
+    uint8_t low = ~levels;
+    for (bool grew = true; grew;) {
+      grew = false;
+      for (int r = 0; r < 4; r++) {
+        for (int c = 0; c < 4; c++) {
+          const uint8_t nets = (1 << r) | (1 << (4 + c));
+          if (keys[r][c] && (low & nets) != 0 && (low & nets) != nets) {
+            low |= nets;
+            grew = true;
+          }
+        }
+      }
+    }
+    return ~low;
+  };
+  SimPCF8574 sim8574(ADDR_8574);
+  SimPCA9534 sim9534(ADDR_9534);
+  sim8574.setLoad(matrix);
+  sim9534.setLoad(matrix);
+  Wire.bus().attach(&sim8574);
+  Wire.bus().attach(&sim9534);
+  I2CParallel8574 dev8574;
+  I2CParallel9534 dev9534;
+  dev8574.init(ADDR_8574);
+  dev9534.init(ADDR_9534);
+  I2CParallelMatrix matrix8574(dev8574, ROWS, COLS);
+  I2CParallelMatrix matrix9534(dev9534, ROWS, COLS);
+
+  struct {
+    const char* name;
+    I2CParallel& dev;
+    I2CParallelMatrix& matrix;
+  } devices[] = { { "8574", dev8574, matrix8574 }, { "9534", dev9534, matrix9534 } };
+
+  keys[2][1] = true;
+  for (auto& d : devices) {
+    // One row driven low at a time; setByte() on a '9534 needs the rows as outputs.
+    d.dev.enableInputs(d.name[0] == '8' ? I2C_PARALLEL_MAX_VAL : COLS);
+    uint8_t found = 0;
+    measure(d.name, "matrix 4x4 setByte+getByte", [&] {
+      for (uint8_t r = 0; r < 4; r++) {
+        d.dev.setByte(~(1 << r));
+        if ((d.dev.getByte() & COLS) != COLS) {
+          found++;
+        }
+      }
+    });
+    d.matrix.begin();
+    d.matrix.scan(); // Sets up the OUTPUT register on a '9534.
+    bool ok = false;
+    measure(d.name, "matrix 4x4 scan()", [&] { ok = d.matrix.scan(); });
+    printf("%-6s %-24s ok=%d pressed=%u (row 2 cols 0x%02x); setByte+getByte saw %u\n", d.name,
+        "", ok, d.matrix.numPressed(), d.matrix.getRow(2), found);
+    check(ok && d.matrix.numPressed() == found, "matrix scan() finds the pressed keys");
+    // Rows released after the scan: latched high on a '8574, inputs on a '9534.
+    const uint8_t released = d.name[0] == '8' ? sim8574.latch() : sim9534.configReg();
+    check((released & ROWS) == ROWS, "matrix scan() leaves every row released");
+  }
+
+  keys[2][1] = false;
+  keys[0][0] = keys[0][1] = true;
+  for (auto& d : devices) {
+    d.matrix.scan();
+    keys[1][0] = true;
+    d.matrix.scan();
+    printf("%-6s %-24s ghosted=%d pressed=%u (rows 0x%02x 0x%02x)\n", d.name, "matrix ghost",
+        d.matrix.isGhosted(), d.matrix.numPressed(), d.matrix.getRow(0), d.matrix.getRow(1));
+    check(d.matrix.isGhosted() && d.matrix.numPressed() == 2, "matrix blocks ghosted presses");
+    keys[1][0] = false;
+  }
+
+  // An empty scan must not vouch for registers it never wrote.
+  for (auto& d : devices) {
+    d.dev.invalidateCache();
+    d.dev.scanRows(nullptr, 0, nullptr);
+    Wire.bus().resetCounters();
+    d.dev.setByte(d.dev.getLastOutputState());
+    check(Wire.bus().counters().starts == 1, "scanRows() with no rows leaves the cache invalid");
+  }
+
+  Wire.bus().detachAll();
+}
+
+// 8-channel PWM on a '8574 (duty 0/32, 4/32, ... 28/32) as one setBit() /
+// clrBit() per edge vs. one waveform burst per period; and a 4-phase stepper
+// sequence whose segments fold into setBytes()' repeat count.
+static void benchWaveform() {
+  SimPCF8574 sim(ADDR_8574);
+  Wire.bus().attach(&sim);
+  I2CParallel8574 dev;
+  dev.init(ADDR_8574);
+  dev.setByte(0x00);
+
+  static constexpr uint16_t PERIOD = 32;
+  measure("wave", "PWM x8 setBit/clrBit", [&] {
+    for (uint8_t pin = 1; pin < 8; pin++) {
+      dev.setBit(pin);
+    }
+    for (uint8_t pin = 1; pin < 8; pin++) {
+      dev.clrBit(pin);
+    }
+  });
+
+  I2CParallelWaveform pwm(dev, PERIOD);
+  for (uint8_t pin = 0; pin < 8; pin++) {
+    pwm.setDuty(pin, pin * 4);
+  }
+  const bool compiled = pwm.compile();
+  const uint32_t latchesBefore = sim.latchCount();
+  measure("wave", "PWM x8 play() 1 period", [&] { pwm.play(); });
+  // Duty actually encoded per pin, in ticks.
+  char duties[64];
+  int len = 0;
+  for (uint8_t pin = 0; pin < 8; pin++) {
+    unsigned high = 0;
+    for (uint8_t i = 0; i < pwm.getNumSteps(); i++) {
+      high += ((pwm.getSteps()[i] >> pin) & 1) * pwm.getRepeat();
+    }
+    len += snprintf(duties + len, sizeof(duties) - len, "%s%u", pin ? "," : "", high);
+  }
+  printf("%-6s %-24s compiled=%d steps=%u repeat=%u latched=%u duty/32=%s; tick %u ns\n",
+      "wave", "", compiled, pwm.getNumSteps(), pwm.getRepeat(),
+      (unsigned)(sim.latchCount() - latchesBefore), duties,
+      I2CParallelWaveform::tickNanos(I2C_SPEED_FAST));
+  // Pin p falls at tick 4p: step i holds the pins above i high, for 4 ticks.
+  bool pwmSteps = compiled && pwm.getNumSteps() == 8 && pwm.getRepeat() == 4;
+  for (uint8_t i = 0; pwmSteps && i < 8; i++) {
+    pwmSteps = pwm.getSteps()[i] == (uint8_t)(0xFE << i);
+  }
+  check(pwmSteps && strcmp(duties, "0,4,8,12,16,20,24,28") == 0,
+      "wave: PWM compiles to one falling edge per pin at tick 4 * pin");
+  check(sim.latchCount() - latchesBefore == PERIOD && sim.latch() == 0x00,
+      "wave: play() latches one byte per tick of the period");
+  bool tickExact = true;
+  for (uint32_t speed : { 100000UL, 123457UL, 400000UL, 1000000UL, 3400000UL }) {
+    tickExact = tickExact && I2CParallelWaveform::tickNanos(speed) == 9000000000ULL / speed;
+  }
+  check(I2CParallelWaveform::tickNanos(I2C_SPEED_FAST) == 22500 && tickExact,
+      "wave: 32-bit tickNanos() matches 9e9 / busSpeed");
+
+  // Full-step 4-phase stepper: one coil on per quarter period.
+  I2CParallelWaveform stepper(dev, 64);
+  for (uint8_t coil = 0; coil < 4; coil++) {
+    const uint16_t edges[2] = { (uint16_t)(coil * 16), (uint16_t)(coil * 16 + 16) };
+    stepper.setTimeline(coil, false, edges, coil == 3 ? 1 : 2);
+  }
+  stepper.compile();
+  measure("wave", "stepper play() 1 period", [&] { stepper.play(); });
+  printf("%-6s %-24s steps=%u repeat=%u seq=%02x %02x %02x %02x\n", "wave", "",
+      stepper.getNumSteps(), stepper.getRepeat(), stepper.getSteps()[0], stepper.getSteps()[1],
+      stepper.getSteps()[2], stepper.getSteps()[3]);
+  check(stepper.getNumSteps() == 4 && stepper.getRepeat() == 16 && stepper.getSteps()[0] == 0x01
+          && stepper.getSteps()[1] == 0x02 && stepper.getSteps()[2] == 0x04
+          && stepper.getSteps()[3] == 0x08 && sim.latch() == 0x08,
+      "wave: stepper energises coils 0-3 in turn, 16 ticks each");
+
+  Wire.bus().detachAll();
+}
+
+// A status LED pair on one '8574 and a 6-pin field straddling two: pin by pin
+// with setBit() / clrBit() vs. an I2CParallelPinMap.
+static void benchPins() {
+  static constexpr uint8_t ADDR_B = ADDR_8574 + 1;
+  SimPCF8574 simA(ADDR_8574);
+  SimPCF8574 simB(ADDR_B);
+  Wire.bus().attach(&simA);
+  Wire.bus().attach(&simB);
+  I2CParallel8574 devA;
+  I2CParallel8574 devB;
+  devA.init(ADDR_8574);
+  devB.init(ADDR_B);
+  devA.setByte(0x00);
+  devB.setByte(0x00);
+
+  typedef I2CParallelPin<0, 0> LedRed;
+  typedef I2CParallelPin<0, 1> LedGreen;
+  typedef I2CParallelField<0, 5, 6> Level; // devA bits 5-7, devB bits 0-2.
+  I2CParallelPinMap<2> pins(devA, devB);
+
+  static constexpr uint8_t LEVEL = 0x2D;
+  measure("pins", "2 LEDs setBit()", [&] {
+    devA.setBit(0);
+    devA.setBit(1);
+  });
+  measure("pins", "6-bit field setBit()...", [&] {
+    for (uint8_t i = 0; i < 6; i++) {
+      I2CParallel& dev = i < 3 ? devA : devB;
+      const uint8_t bit = (5 + i) % 8;
+      if ((LEVEL >> i) & 1) {
+        dev.setBit(bit);
+      } else {
+        dev.clrBit(bit);
+      }
+    }
+  });
+  const uint8_t latchA = simA.latch();
+  const uint8_t latchB = simB.latch();
+
+  devA.setByte(0x00);
+  devB.setByte(0x00);
+  measure("pins", "set<LedRed, LedGreen>", [&] { pins.set<LedRed, LedGreen>(); });
+  measure("pins", "write<Level>", [&] { pins.write<Level>(LEVEL); });
+  printf("%-6s %-24s latches %02x %02x (pin by pin %02x %02x) get<Level>=0x%02x\n", "pins", "",
+      simA.latch(), simB.latch(), latchA, latchB, (unsigned)pins.get<Level>());
+  check(simA.latch() == latchA && simB.latch() == latchB && pins.get<Level>() == LEVEL,
+      "pin map writes match pin-by-pin writes");
+
+  Wire.bus().detachAll();
+}
+
+// Several threads (standing in for cores / RTOS tasks) toggling their own pin
+// of one device: a mutex around each I2CParallel call vs. I2CParallelShared.
+// The simulated bus is not thread-safe, so a lost update or an unserialized
+// transaction shows up as a wrong final latch. Wall-clock rates depend on the
+// host; the writes per operation are what carries over to a real bus.
+static void benchShared() {
+  static constexpr uint8_t NUM_THREADS = 4;
+  static constexpr uint32_t TOGGLES = 20001; // Odd: every thread's pin ends high.
+
+  SimPCF8574 sim(ADDR_8574);
+  Wire.bus().attach(&sim);
+  I2CParallel8574 dev;
+  dev.init(ADDR_8574);
+
+  // Every pin starts low.
+  auto run = [&](const char* name, std::function<void(uint8_t)> toggle) {
+    const uint32_t latchesBefore = sim.latchCount();
+    const uint64_t busBefore = SimClock::nowNanos();
+    const auto start = std::chrono::steady_clock::now();
+    std::thread threads[NUM_THREADS];
+    for (uint8_t t = 0; t < NUM_THREADS; t++) {
+      threads[t] = std::thread([&toggle, t] {
+        for (uint32_t i = 0; i < TOGGLES; i++) {
+          toggle(t);
+        }
+      });
+    }
+    for (uint8_t t = 0; t < NUM_THREADS; t++) {
+      threads[t].join();
+    }
+    const double secs =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const uint32_t ops = NUM_THREADS * TOGGLES;
+    const uint32_t writes = sim.latchCount() - latchesBefore;
+    printf("%-6s %-24s latch=0x%02x (want 0x%02x) writes/op=%.3f bus=%.1f us/op "
+           "host=%.2f Mops/s\n",
+        "shared", name, sim.latch(), (1 << NUM_THREADS) - 1, (double)writes / ops,
+        (SimClock::nowNanos() - busBefore) / 1000.0 / ops, ops / secs / 1e6);
+    check(sim.latch() == (1 << NUM_THREADS) - 1, "no toggle lost under contention");
+  };
+
+  dev.setByte(0x00);
+  std::mutex mutex;
+  run("mutex + toggleBit", [&](uint8_t pin) {
+    std::lock_guard<std::mutex> guard(mutex);
+    dev.toggleBit(pin);
+  });
+
+  dev.setByte(0x00);
+  I2CParallelBusLock lock;
+  I2CParallelShared shared(dev, lock);
+  const uint32_t latchesBefore = sim.latchCount();
+  run("I2CParallelShared", [&](uint8_t pin) { shared.toggleBit(pin); });
+  check(lock.getWriteCount() == sim.latchCount() - latchesBefore,
+      "I2CParallelShared counts every write made by a bus owner");
+
+  Wire.bus().detachAll();
+}
+
+// Two 100 kHz '8574s and three 400 kHz '9534s on one bus, each written once
+// per loop iteration in an interleaved order: switching the clock before each
+// write as needed vs. grouping the writes with an I2CParallelScheduler.
+static void benchScheduler() {
+  static constexpr uint8_t NUM_DEVICES = 5;
+  static constexpr uint16_t ROUNDS = 20;
+  SimPCF8574 sim8574[2] = { SimPCF8574(ADDR_8574), SimPCF8574(ADDR_8574 + 2) };
+  SimPCA9534 sim9534[3] = { SimPCA9534(ADDR_9534), SimPCA9534(ADDR_9534 + 1),
+    SimPCA9534(ADDR_9534 + 2) };
+  I2CParallel8574 dev8574[2];
+  I2CParallel9534 dev9534[3];
+  for (uint8_t i = 0; i < 2; i++) {
+    Wire.bus().attach(&sim8574[i]);
+    dev8574[i].init(ADDR_8574 + 2 * i, I2C_SPEED_STANDARD);
+  }
+  for (uint8_t i = 0; i < 3; i++) {
+    Wire.bus().attach(&sim9534[i]);
+    dev9534[i].init(ADDR_9534 + i, I2C_SPEED_FAST);
+    dev9534[i].enableInputs(0x00);
+  }
+  I2CParallel* devs[NUM_DEVICES] = { &dev9534[0], &dev8574[0], &dev9534[1], &dev8574[1],
+    &dev9534[2] };
+
+  auto report = [&](const char* name, const uint64_t startNanos) {
+    const SimBusCounters& c = Wire.bus().counters();
+    printf("%-6s %-24s clock switches=%u bus=%.1f us/round\n", "sched", name, c.clockChanges,
+        (SimClock::nowNanos() - startNanos) / 1000.0 / ROUNDS);
+  };
+
+  Wire.bus().resetCounters();
+  uint64_t start = SimClock::nowNanos();
+  for (uint16_t r = 0; r < ROUNDS; r++) {
+    for (uint8_t d = 0; d < NUM_DEVICES; d++) {
+      Wire.setClock(devs[d]->getBusSpeed());
+      devs[d]->setByte((uint8_t)(r + d));
+    }
+  }
+  report("setClock per device", start);
+
+  I2CParallelAsync queues[NUM_DEVICES] = { I2CParallelAsync(*devs[0]),
+    I2CParallelAsync(*devs[1]), I2CParallelAsync(*devs[2]), I2CParallelAsync(*devs[3]),
+    I2CParallelAsync(*devs[4]) };
+  I2CParallelScheduler sched;
+  for (uint8_t d = 0; d < NUM_DEVICES; d++) {
+    sched.add(queues[d]);
+  }
+  Wire.bus().resetCounters();
+  start = SimClock::nowNanos();
+  for (uint16_t r = 0; r < ROUNDS; r++) {
+    for (uint8_t d = 0; d < NUM_DEVICES; d++) {
+      queues[d].queueWrite((uint8_t)(r + d + 1));
+    }
+    sched.run();
+  }
+  report("I2CParallelScheduler", start);
+  for (uint8_t s = 0; s < sched.numSpeeds(); s++) {
+    printf("%-6s %-24s %6lu Hz: %4lu ops %8lu us\n", "sched", "", (unsigned long)sched.getSpeed(s),
+        (unsigned long)sched.getOpsAt(s), (unsigned long)sched.getMicrosAt(s));
+  }
+  const bool ok = sim8574[0].latch() == ROUNDS + 1 && sim8574[1].latch() == ROUNDS + 3
+      && sim9534[2].outputReg() == ROUNDS + 4;
+  printf("%-6s %-24s final outputs %s\n", "sched", "", ok ? "ok" : "WRONG");
+  check(ok, "scheduler performs every queued write");
+
+  Wire.bus().detachAll();
+}
+
+// Recovering a '9538 after RESET_L or a brownout: rebuilding the registers one
+// call at a time vs. replaying the cached state.
+static void benchRecovery() {
+  static constexpr uint8_t ADDR = 0x71;
+  static constexpr uint8_t RESET_PIN = 7;
+  SimPCA9538 sim(ADDR, RESET_PIN);
+  Wire.bus().attach(&sim);
+  I2CParallel9538 dev(RESET_PIN);
+  dev.init(ADDR);
+  auto configure = [&] {
+    dev.setByte(0xA5);
+    dev.setInputPolarity(0x03);
+    dev.enableInputs(0x0F);
+  };
+  configure();
+
+  measure("9538", "reset + reconfigure", [&] {
+    dev.reset();
+    configure();
+  });
+  dev.setRestoreOnReset(true);
+  measure("9538", "reset (restore on reset)", [&] { dev.reset(); });
+  measure("9538", "checkBrownout (ok)", [&] { dev.checkBrownout(); });
+  sim.powerOnReset();
+  // Record the order of the restore writes: OUTPUT must be in place before
+  // CONFIG turns any pin into an output.
+  uint8_t restoreOrder[4];
+  uint8_t numRestoreWrites = 0;
+  sim.setWriteHook([&](uint8_t reg, uint8_t val) {
+    if (numRestoreWrites < sizeof(restoreOrder)) {
+      restoreOrder[numRestoreWrites++] = reg;
+    }
+  });
+  const SimBusCounters brownout =
+      measure("9538", "checkBrownout (brownout)", [&] { dev.checkBrownout(); });
+  sim.setWriteHook(nullptr);
+  printf("%-6s %-24s out=0x%02x pol=0x%02x cfg=0x%02x brownouts=%u error=%u\n", "9538",
+      "after recovery", sim.outputReg(), sim.polarityReg(), sim.configReg(),
+      dev.getBrownoutCount(), dev.getError());
+  check(sim.outputReg() == 0xA5 && sim.polarityReg() == 0x03 && sim.configReg() == 0x0F,
+      "9538: checkBrownout() restores OUTPUT, POLARITY and CONFIG");
+  check(dev.getBrownoutCount() == 1 && !dev.hasError(), "9538: one brownout found, no error");
+  check(numRestoreWrites == 3 && restoreOrder[0] == SimPCA9534::REG_OUTPUT
+          && restoreOrder[2] == SimPCA9534::REG_CONFIG,
+      "9538: restore writes OUTPUT first and CONFIG last");
+  // One read to detect the reset, then the restore in a single transaction.
+  check(brownout.stops == 2, "9538: restore writes share one transaction");
+
+  Wire.bus().detachAll();
+}
+
+// Simulated time taken by `fn`, in microseconds.
+template <typename Fn>
+static uint32_t elapsedMicros(Fn fn) {
+  const uint32_t start = micros();
+  fn();
+  return micros() - start;
+}
+
+// A healthy device sharing the bus with one that has gone missing, and a bus
+// wedged by a device holding SDA low.
+static void benchRetry() {
+  static constexpr uint8_t SDA_PIN = 18;
+  static constexpr uint8_t SCL_PIN = 19;
+  static constexpr int NUM_LOOPS = 100;
+  SimPCA9534 simGood(ADDR_9534);
+  SimPCF8574 simBad(ADDR_8574);
+  Wire.bus().attach(&simGood);
+  Wire.bus().attach(&simBad);
+  Wire.bus().connectPins(SDA_PIN, SCL_PIN);
+  I2CParallel9534 good;
+  I2CParallel8574 bad;
+  good.init(ADDR_9534);
+  bad.init(ADDR_8574);
+  good.enableInputs(0x0F);
+
+  const I2CParallelRetryPolicy policy = {
+    3,      // maxAttempts
+    2000,   // budgetMicros
+    100,    // backoffMicros
+    6,      // breakerThreshold
+    100000, // probeIntervalMicros
+    1000,   // wireTimeoutMicros
+    SDA_PIN, SCL_PIN,
+  };
+  bad.setRetryPolicy(policy);
+  good.setRetryPolicy(policy);
+
+  // Each loop iteration: one write to each device, 1 ms apart.
+  auto controlLoop = [&] {
+    for (int i = 0; i < NUM_LOOPS; i++) {
+      good.setByte(i);
+      bad.setByte(i);
+      delay(1);
+    }
+  };
+  simBad.setPresent(false);
+  measure("retry", "setByte (absent, 3 tries)", [&] { bad.setByte(0x11); });
+  bad.clearError();
+  measure("retry", "loop x100 (breaker)", controlLoop);
+  printf("%-6s %-24s circuitOpen=%d good error=%u\n", "retry", "", bad.isCircuitOpen(),
+      good.getError());
+  check(bad.isCircuitOpen(), "retry: the breaker opens for the absent device");
+  check(!good.hasError(), "retry: the healthy device is unaffected");
+  simBad.setPresent(true);
+  delay(100);
+  measure("retry", "setByte (probe, back)", [&] { bad.setByte(0x22); });
+  printf("%-6s %-24s circuitOpen=%d latch=0x%02x\n", "retry", "", bad.isCircuitOpen(),
+      simBad.latch());
+  check(!bad.isCircuitOpen() && simBad.latch() == 0x22,
+      "retry: the probe closes the breaker and writes the port");
+
+  // SDA held low: without recovery each call waits out the Wire timeout.
+  bad.setRetryPolicy(I2C_PARALLEL_DEFAULT_RETRY_POLICY);
+  Wire.bus().holdSda(5);
+  const uint32_t stuckMicros = elapsedMicros([&] {
+    for (int i = 0; i < 10; i++) {
+      bad.setByte(0x40 + i);
+    }
+  });
+  // A device with recovery pins frees the bus and retries. (The Wire timeout is
+  // shared by every device on the controller; the last policy set wins.)
+  good.setRetryPolicy(policy);
+  uint8_t ok = 0;
+  const uint32_t recoverMicros = elapsedMicros([&] { ok = good.setByte(0x33); });
+  printf("%-6s %-24s stuck x10=%u us; recover+retry=%u us ok=%u out=0x%02x\n", "retry",
+      "SDA held low", stuckMicros, recoverMicros, ok, simGood.outputReg());
+  // Each stuck call gives up after one Wire timeout (plus the address frame).
+  check(stuckMicros <= 10 * (I2C_PARALLEL_WIRE_TIMEOUT + 1000),
+      "retry: each call on the stuck bus gives up after one Wire timeout");
+  check(ok == 1 && simGood.outputReg() == 0x33, "retry: recovery frees the bus and the retry lands");
+  check(recoverMicros <= policy.wireTimeoutMicros + policy.budgetMicros,
+      "retry: recovery and retry fit in one timeout plus the retry budget");
+
+#ifdef I2C_PARALLEL_ENABLE_STATS
+  for (const I2CParallel* d : { static_cast<I2CParallel*>(&bad), static_cast<I2CParallel*>(&good) }) {
+    const I2CParallelStats& stats = d->getStats();
+    printf("%-6s stats 0x%02x               retries=%u rejected=%u recoveries=%u timeouts=%u\n",
+        "retry", d->getAddress(), stats.retries, stats.rejected, stats.recoveries, stats.timeouts);
+  }
+  // The absent device: 2 retries each for the first call and the call that
+  // opens the breaker, 98 calls refused, and the 10 stuck calls timed out.
+  const I2CParallelStats& badStats = bad.getStats();
+  check(badStats.rejected > 0, "retry: the open breaker refuses calls");
+  check(badStats.retries == 4 && badStats.rejected == 98 && badStats.recoveries == 0
+          && badStats.timeouts == 10,
+      "retry stats for the absent device");
+  // The healthy device: one timeout, one recovery, one successful retry.
+  const I2CParallelStats& goodStats = good.getStats();
+  check(goodStats.retries == 1 && goodStats.rejected == 0 && goodStats.recoveries == 1
+          && goodStats.timeouts == 1,
+      "retry stats for the recovering device");
+#endif /* I2C_PARALLEL_ENABLE_STATS */
+
+  Wire.bus().detachAll();
+  SimGpio::reset();
+}
+
+// Time spent in waitForValid() after a write: the part of the hold time not
+// already covered by the STOP condition or by other work, against the fixed
+// per-chip delay it replaces.
+static void benchSettle() {
+  SimPCF8574 sim8574(ADDR_8574);
+  SimPCA9534 sim9534(ADDR_9534);
+  Wire.bus().attach(&sim8574);
+  Wire.bus().attach(&sim9534);
+  I2CParallel8574 dev8574;
+  I2CParallel9534 dev9534;
+
+  struct {
+    const char* name;
+    I2CParallel& dev;
+    uint8_t addr;
+    uint32_t fixedMicros; // The delay waitForValid() used to apply.
+  } devices[] = { { "8574", dev8574, ADDR_8574, 4 }, { "9534", dev9534, ADDR_9534, 1 } };
+
+  auto waitNanos = [](I2CParallel& dev) {
+    const uint64_t start = SimClock::nowNanos();
+    dev.waitForValid();
+    return static_cast<unsigned long long>(SimClock::nowNanos() - start);
+  };
+
+  for (auto& d : devices) {
+    for (uint32_t speed : { I2C_SPEED_STANDARD, I2C_SPEED_FAST }) {
+      d.dev.init(d.addr, speed);
+      d.dev.setByte(0x00);
+      const bool validAtOnce = d.dev.isValid();
+      const unsigned long long afterStop = waitNanos(d.dev);
+      d.dev.setByte(0xFF);
+      delayMicroseconds(5); // Other work between the write and the read-back.
+      const bool validAfterWork = d.dev.isValid();
+      const unsigned long long afterWork = waitNanos(d.dev);
+      printf("%-6s waitForValid @%3ukHz     %llu ns after STOP (isValid=%d), %llu ns after 5us "
+             "(isValid=%d); fixed delay %u ns\n",
+          d.name, speed / 1000, afterStop, validAtOnce, afterWork, validAfterWork,
+          d.fixedMicros * 1000);
+    }
+  }
+
+  Wire.bus().detachAll();
+}
+
+// Startup enumeration of a 16-expander board: 6 PCF8574 and 2 PCA9534 at
+// 0x20--0x27, 6 PCA9534A at 0x38--0x3D and 2 PCA9538 at 0x70--0x71. Compared
+// against calling init() and getByte() for every candidate address at 100 kHz.
+static void benchDiscovery() {
+  static constexpr uint8_t RESET_PIN_A = 8;
+  static constexpr uint8_t RESET_PIN_B = 9;
+  SimPCF8574 sim8574[6] = { SimPCF8574(0x20), SimPCF8574(0x21), SimPCF8574(0x22),
+    SimPCF8574(0x23), SimPCF8574(0x24), SimPCF8574(0x25) };
+  SimPCA9534 sim9534[8] = { SimPCA9534(0x26), SimPCA9534(0x27), SimPCA9534(0x38),
+    SimPCA9534(0x39), SimPCA9534(0x3A), SimPCA9534(0x3B), SimPCA9534(0x3C), SimPCA9534(0x3D) };
+  SimPCA9538 sim9538a(0x70, RESET_PIN_A);
+  SimPCA9538 sim9538b(0x71, RESET_PIN_B);
+  for (SimPCF8574& sim : sim8574) {
+    Wire.bus().attach(&sim);
+  }
+  for (SimPCA9534& sim : sim9534) {
+    Wire.bus().attach(&sim);
+  }
+  Wire.bus().attach(&sim9538a);
+  Wire.bus().attach(&sim9538b);
+
+  // Baseline: try each candidate address with a driver and a read.
+  uint8_t numAnswered = 0;
+  const uint32_t naiveMicros = elapsedMicros([&] {
+    for (uint8_t addr : { 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x38, 0x39, 0x3A, 0x3B,
+             0x3C, 0x3D, 0x3E, 0x3F, 0x70, 0x71, 0x72, 0x73 }) {
+      I2CParallel9534 dev;
+      dev.init(addr, I2C_SPEED_STANDARD);
+      uint8_t n = 0;
+      static_cast<I2CParallel&>(dev).getByte(n);
+      numAnswered += n;
+    }
+  });
+
+  // A warm reboot: one '9534 left with pins 2--7 as outputs, and one PCF8574
+  // left driving a pattern. The baseline has latched 0x00 onto the others.
+  I2CParallel9534 warm9534;
+  warm9534.init(0x26);
+  warm9534.enableInputs(0x03);
+  I2CParallel8574 warm8574;
+  warm8574.init(0x21);
+  warm8574.setByte(0x5A);
+  uint8_t latchesBefore[6];
+  for (int i = 0; i < 6; i++) {
+    latchesBefore[i] = sim8574[i].latch();
+  }
+
+  I2CParallel8574 pcf8574[8];
+  I2CParallel9534 pca9534[8];
+  I2CParallel9538 pca9538[2] = { I2CParallel9538(RESET_PIN_A), I2CParallel9538(RESET_PIN_B) };
+  const I2CParallelPool pool = { pcf8574, 8, pca9534, 8, pca9538, 2 };
+  I2CParallel* devices[I2C_PARALLEL_BANK_MAX_DEVICES];
+  I2CParallelDiscovery discovery;
+  uint8_t numBuilt = 0;
+  measure("disc", "discover (16 devices)", [&] {
+    numBuilt = discovery.discover(pool, devices, I2C_PARALLEL_BANK_MAX_DEVICES);
+  });
+
+  uint8_t counts[4] = { 0, 0, 0, 0 };
+  for (uint8_t i = 0; i < discovery.size(); i++) {
+    counts[discovery.found()[i].chip]++;
+  }
+  uint8_t latched = 0;
+  for (int i = 0; i < 6; i++) {
+    latched += sim8574[i].latch() == latchesBefore[i];
+  }
+  printf("%-6s %-24s built=%u (8574=%u 9534=%u 9538=%u) in %u us; per-address init+read "
+         "%u us (%u answered); 8574 latches kept: %u/6\n",
+      "disc", "", numBuilt, counts[I2C_PARALLEL_CHIP_8574], counts[I2C_PARALLEL_CHIP_9534],
+      counts[I2C_PARALLEL_CHIP_9538], discovery.getLastScanMicros(), naiveMicros, numAnswered,
+      latched);
+  check(numBuilt == 16 && counts[I2C_PARALLEL_CHIP_8574] == 6 && counts[I2C_PARALLEL_CHIP_9534] == 8
+          && counts[I2C_PARALLEL_CHIP_9538] == 2 && latched == 6,
+      "discovery identifies every device and restores '8574 latches");
+  check(discovery.chipAt(0x26) == I2C_PARALLEL_CHIP_9534 && sim9534[0].configReg() == 0x03,
+      "discovery identifies a '9534 with pins 2-7 as outputs and leaves CONFIG alone");
+  check(sim8574[1].latch() == 0x5A, "discovery leaves a '8574 driving its outputs");
+
+  // A scan on its own must hand the bus back at its normal settings.
+  Wire.setClock(I2C_SPEED_STANDARD);
+  discovery.scan(I2C_SPEED_STANDARD, 5000);
+  check(Wire.bus().getClock() == I2C_SPEED_STANDARD && Wire.bus().getTimeoutMicros() == 5000,
+      "discovery scan() restores the bus clock and timeout");
+
+  Wire.bus().detachAll();
+  SimGpio::reset();
+}
+
+// TCAL6408 agile I/O: register setup, and catching a short input pulse that
+// happens between two polls, with and without the input latch.
+static void benchTCAL6408() {
+  static constexpr int NUM_POLLS = 100;
+  SimTCAL6408 sim(ADDR_TCAL6408, RESET_PIN_TCAL6408);
+  Wire.bus().attach(&sim);
+  I2CParallelTCAL6408 dev(RESET_PIN_TCAL6408);
+  I2CParallel& base = dev;
+
+  measure("6408L", "init", [&] { dev.init(ADDR_TCAL6408); });
+  measure("6408L", "reset", [&] { dev.reset(); });
+  measure("6408L", "enableInputs", [&] { dev.enableInputs(0x0F); });
+  measure("6408L", "setInterruptMask", [&] { dev.setInterruptMask(0xF0); });
+  measure("6408L", "setPullResistors", [&] { dev.setPullResistors(0x0F, 0x0F); });
+  measure("6408L", "setDriveStrength (1 pin)", [&] {
+    dev.setDriveStrength(4, I2C_PARALLEL_DRIVE_0_5X);
+  });
+  measure("6408L", "setOpenDrain (same)", [&] { dev.setOpenDrain(false); });
+  measure("6408L", "getInterruptStatus", [&] { dev.getInterruptStatus(); });
+  measure("6408L", "getChangedPins", [&] { dev.getChangedPins(); });
+
+  // Each run: pin 0 pulses low and back high between polls 50 and 51.
+  auto pulseRun = [&](auto poll) {
+    int numSeen = 0;
+    for (int i = 0; i < NUM_POLLS; i++) {
+      if (i == 50) {
+        sim.setInputs(0xFE);
+        sim.setInputs(0xFF);
+      }
+      numSeen += poll();
+    }
+    return numSeen;
+  };
+  int seenDiff = 0;
+  int seenLatch = 0;
+  measure("6408L", "poll getByte x100", [&] {
+    seenDiff = pulseRun([&] {
+      const uint8_t before = dev.getLastInputState();
+      return (base.getByte() ^ before) & 0x01 ? 1 : 0;
+    });
+  });
+  dev.setInputLatch(0x0F);
+  measure("6408L", "getChangedPins x100", [&] {
+    seenLatch = pulseRun([&] { return (dev.getChangedPins() & 0x01) ? 1 : 0; });
+  });
+  printf("%-6s %-24s diff=%d latched=%d\n", "6408L", "pulses seen", seenDiff, seenLatch);
+  check(seenDiff == 0, "6408L: polling getByte() misses the pulse between polls");
+  check(seenLatch == 1, "6408L: the input latch catches the pulse exactly once");
+
+  // reset() through the '9538 base also restores the agile I/O cache.
+  I2CParallel9538& as9538 = dev;
+  as9538.reset();
+  check(dev.getLastInputLatchState() == 0 && dev.getLastInterruptMaskState() == 0xFF,
+      "6408L: reset() through I2CParallel9538 resets the agile I/O registers");
+
+  // Addresses a '9538 accepts but the TCAL6408 does not answer at.
+  dev.init(I2C_PCA9538_MIN_ADDR);
+  check(dev.getError() == I2C_PARALLEL_ERR_ADDR, "6408L: init() rejects 0x70");
+  dev.init(0x22);
+  check(dev.getError() == I2C_PARALLEL_ERR_ADDR, "6408L: init() rejects 0x22");
+  dev.init(ADDR_TCAL6408);
+  check(!dev.hasError(), "6408L: init() accepts 0x21");
+
+  Wire.bus().detachAll();
+}
+
+// A control loop that updates the outputs 10 times per iteration and reads
+// the inputs once, through the async queue.
+static void benchAsync() {
+  SimPCA9534 sim(ADDR_9534);
+  Wire.bus().attach(&sim);
+  I2CParallel9534 dev;
+  dev.init(ADDR_9534);
+  I2CParallelAsync async(dev);
+  I2CParallelReadHandle handle;
+
+  uint32_t maxPollNanos = 0;
+  measure("async", "10 writes + 1 read", [&] {
+    for (uint8_t i = 0; i < 10; i++) {
+      async.queueWrite(i);
+    }
+    async.queueRead(handle);
+    while (!async.isEmpty()) {
+      const uint64_t start = SimClock::nowNanos();
+      async.poll();
+      const uint32_t elapsed = static_cast<uint32_t>(SimClock::nowNanos() - start);
+      maxPollNanos = elapsed > maxPollNanos ? elapsed : maxPollNanos;
+    }
+  });
+  printf("%-6s %-24s %u coalesced, longest poll %u us, read %s\n", "async", "",
+      async.getCoalescedCount(), maxPollNanos / 1000, handle.isOk() ? "ok" : "failed");
+  check(handle.isOk() && sim.outputReg() == 9, "async coalesced writes end at the newest value");
+
+  // Writes of different kinds must not be folded across each other.
+  const uint16_t coalescedBefore = async.getCoalescedCount();
+  async.queueWrite(0xAA);
+  async.queueEnableInputs(0xF0);
+  async.queueWrite(0x55);
+  async.flush();
+  check(sim.outputReg() == 0x55 && sim.configReg() == 0xF0
+          && async.getCoalescedCount() == coalescedBefore,
+      "async keeps OUTPUT and CONFIG writes in order");
+
+  // With no write queued, the pending output is whatever the device holds now.
+  dev.setByte(0x3C);
+  async.queueEnableInputs(0x0F);
+  check(async.getPendingOutput() == 0x3C, "async pending output follows direct writes");
+  async.flush();
+
+  SimPCF8574 sim8574(ADDR_8574);
+  Wire.bus().attach(&sim8574);
+  I2CParallel8574 dev8574;
+  dev8574.init(ADDR_8574);
+  I2CParallelAsync async8574(dev8574);
+  async8574.queueWrite(0x00);
+  async8574.queueEnableInputs(0x0F);
+  async8574.queueWrite(0x10);
+  async8574.flush();
+  check(sim8574.latch() == 0x10 && async8574.getPendingOutput() == 0x10
+          && dev8574.getLastOutputState() == 0x10,
+      "async '8574 write after enableInputs wins");
+  async8574.queueEnableInputs(0x01);
+  async8574.queueEnableInputs(0x02);
+  check(async8574.getPendingOutput() == 0x13, "async '8574 enableInputs updates pending output");
+  async8574.flush();
+  check(sim8574.latch() == 0x13, "async '8574 input enables accumulate");
+  printf("%-6s %-24s '8574 latch 0x%02x after write/enable/write/enable/enable\n", "async", "",
+      sim8574.latch());
+
+  Wire.bus().detachAll();
+}
+
+// The compile-time driver, and a device on a second controller (Wire1).
+static void benchTemplate() {
+  SimPCA9534 sim(ADDR_9534);
+  Wire.bus().attach(&sim);
+  I2CParallelT<I2CParallelChip9534> dev(Wire);
+  measure("T9534", "init<0x38>", [&] { dev.init<ADDR_9534>(); });
+  measure("T9534", "setByte", [&] { dev.setByte(0x5A); });
+  measure("T9534", "setByte (same)", [&] { dev.setByte(0x5A); });
+  measure("T9534", "getByte x8", [&] {
+    for (int i = 0; i < 8; i++) {
+      dev.getByte();
+    }
+  });
+  measure("T9534", "toggleBit", [&] { dev.toggleBit(1); });
+  dev.init<ADDR_9534>(I2C_PARALLEL_MAX_BUS_SPEED * 4);
+  const uint8_t speedError = dev.getError();
+  dev.init<ADDR_9534>();
+  check(speedError == I2C_PARALLEL_ERR_BUS_SPEED && !dev.hasError(),
+      "I2CParallelT init<addr>() clears the previous error");
+  Wire.bus().detachAll();
+
+  // reset() drives RESET_L itself; nothing else has made the pin an output.
+  SimGpio::reset();
+  SimPCA9538 sim9538(ADDR_9538, RESET_PIN_9538);
+  Wire.bus().attach(&sim9538);
+  I2CParallelT<I2CParallelChip9538> dev9538(Wire);
+  dev9538.init<ADDR_9538>();
+  dev9538.setByte(0x00);
+  dev9538.reset(RESET_PIN_9538);
+  check(sim9538.resetCount() == 1 && sim9538.outputReg() == I2C_PCA9534_POWER_ON_OUTPUT,
+      "I2CParallelT reset() pulses RESET_L");
+  Wire.bus().detachAll();
+  SimGpio::reset();
+
+  SimPCF8574 sim1(ADDR_8574);
+  Wire1.bus().attach(&sim1);
+  I2CParallel8574 dev1(Wire1);
+  dev1.init(ADDR_8574);
+  measure("Wire1", "setByte (not on Wire)", [&] { dev1.setByte(0xA5); });
+  printf("Wire1  0x%02x latch=0x%02x error=%u\n", ADDR_8574, sim1.latch(), dev1.getError());
+  Wire1.bus().detachAll();
+}
+
+// Per-device statistics: a healthy device next to one that has gone missing.
+static void benchStats() {
+  static const char* const opNames[I2C_PARALLEL_NUM_OPS] = { "write", "read", "config" };
+  SimPCA9534 sim(ADDR_9534);
+  Wire.bus().attach(&sim);
+  I2CParallel9534 dev;
+  dev.init(ADDR_9534);
+  I2CParallel8574 missing;
+  missing.init(ADDR_8574);
+  I2CParallel& base = dev;
+
+  dev.enableInputs(0x0F);
+  for (uint8_t i = 0; i < 20; i++) {
+    dev.setByte(i << 4);
+    base.getByte();
+  }
+  missing.setByte(0x00);
+  static_cast<I2CParallel&>(missing).getByte();
+
+  for (const I2CParallel* d : { static_cast<I2CParallel*>(&dev), static_cast<I2CParallel*>(&missing) }) {
+    const I2CParallelStats& stats = d->getStats();
+    printf("stats  0x%02x: %u transactions, %u bytes written, %u bytes read, %u addr NACKs, "
+           "%u data NACKs, %u timeouts, %u other errors\n",
+        d->getAddress(), stats.transactions, stats.bytesWritten, stats.bytesRead, stats.addrNacks,
+        stats.dataNacks, stats.timeouts, stats.otherErrors);
+    for (uint8_t op = 0; op < I2C_PARALLEL_NUM_OPS; op++) {
+      printf("stats  0x%02x: %-6s latency histogram (log2 us):", d->getAddress(), opNames[op]);
+      for (uint8_t b = 0; b < I2C_PARALLEL_STATS_BUCKETS; b++) {
+        printf(" %u", stats.latency[op][b]);
+      }
+      printf("\n");
+    }
+  }
+
+  // 0x38: one CONFIG write, 20 OUTPUT writes, and 20 reads of two transactions
+  // each (every setByte() moves the register pointer off INPUT).
+  const I2CParallelStats& stats = dev.getStats();
+  uint32_t perOp[I2C_PARALLEL_NUM_OPS] = { 0, 0, 0 };
+  for (uint8_t op = 0; op < I2C_PARALLEL_NUM_OPS; op++) {
+    for (uint8_t b = 0; b < I2C_PARALLEL_STATS_BUCKETS; b++) {
+      perOp[op] += stats.latency[op][b];
+    }
+  }
+  check(stats.transactions == 61 && stats.bytesWritten == 62 && stats.bytesRead == 20
+          && stats.addrNacks == 0 && stats.dataNacks == 0 && stats.timeouts == 0
+          && stats.otherErrors == 0,
+      "stats counters for a healthy device");
+  check(perOp[0] == 20 && perOp[1] == 40 && perOp[2] == 1, "stats latency histograms");
+  check(missing.getStats().addrNacks == 2 && missing.getStats().transactions == 2,
+      "stats count address NACKs");
+
+  Wire.bus().detachAll();
+}
+
+int main() {
+  SimPCF8574 sim8574(ADDR_8574);
+  SimPCA9534 sim9534(ADDR_9534);
+  SimPCA9538 sim9538(ADDR_9538, RESET_PIN_9538);
+  Wire.bus().attach(&sim8574);
+  Wire.bus().attach(&sim9534);
+  Wire.bus().attach(&sim9538);
+
+  I2CParallel8574 dev8574;
+  I2CParallel9534 dev9534;
+  I2CParallel9538 dev9538(RESET_PIN_9538);
+
+  printHeader();
+  measure("8574", "init", [&] { dev8574.init(ADDR_8574); });
+  benchCommon("8574", dev8574, sim8574);
+  measure("9534", "init", [&] { dev9534.init(ADDR_9534); });
+  bench9534("9534", dev9534, sim9534);
+  measure("9538", "init", [&] { dev9538.init(ADDR_9538); });
+  bench9534("9538", dev9538, sim9538);
+  measure("9538", "reset", [&] { dev9538.reset(); });
+
+  benchRecovery();
+  benchRetry();
+  benchSettle();
+  benchDiscovery();
+  benchBank();
+  benchEvents();
+  benchDispatch();
+  benchDebounce();
+  benchMatrix();
+  benchWaveform();
+  benchShared();
+  benchPins();
+  benchScheduler();
+  benchTCAL6408();
+  benchAsync();
+  benchTemplate();
+  benchStats();
+
+  int errors = dev8574.getError() + dev9534.getError() + dev9538.getError();
+  if (errors != 0) {
+    printf("\nerrors: 8574=%u 9534=%u 9538=%u\n", dev8574.getError(), dev9534.getError(),
+        dev9538.getError());
+  }
+  if (gFailures != 0) {
+    printf("\n%d check(s) failed\n", gFailures);
+    return 1;
+  }
+  return 0;
+}
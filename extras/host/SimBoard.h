@@ -0,0 +1,59 @@
+// (c) Copyright 2026 Aaron Kimball
+// This library is licensed under the terms of the BSD 3-Clause license.
+// See the accompanying LICENSE.txt file for full license text.
+//
+// Simulated MCU for the host build: a virtual clock and a small GPIO block.
+// GPIO pins can be wired to the open-drain INT_L outputs of simulated devices,
+// and to listeners that observe the MCU driving a pin (e.g. a device RESET_L).
+
+#ifndef I2C_PARALLEL_SIM_BOARD_H
+#define I2C_PARALLEL_SIM_BOARD_H
+
+#include <cstdint>
+#include <functional>
+
+class SimDevice;
+
+/** Virtual time source backing micros(), millis() and the delay functions. */
+class SimClock {
+public:
+  static uint64_t nowNanos();
+  static void advanceNanos(uint64_t nanos);
+  static void reset();
+};
+
+/** Simulated GPIO block. */
+class SimGpio {
+public:
+  static constexpr uint8_t NUM_PINS = 64;
+
+  typedef std::function<void(uint8_t level)> PinListener;
+
+  typedef std::function<uint8_t()> InputSource;
+
+  // Call `listener` each time the MCU writes a new level to `pin` while it is
+  // configured as an output.
+  static void setListener(uint8_t pin, PinListener listener);
+
+  // Read `pin` from `source` while it is not configured as an output.
+  static void setInputSource(uint8_t pin, InputSource source);
+
+  // Wire the INT_L output of `dev` onto `pin`. The line is open-drain and
+  // reads LOW when any connected device asserts its interrupt.
+  static void connectInt(uint8_t pin, SimDevice* dev);
+
+  // Recompute the level of every INT line and fire attached ISRs on edges.
+  // Called after each bus transaction and each change to simulated inputs.
+  static void refresh();
+
+  static uint8_t read(uint8_t pin);
+  static void write(uint8_t pin, uint8_t level);
+  static void setMode(uint8_t pin, uint8_t mode);
+  static void attach(uint8_t pin, void (*isr)(), int mode);
+  static void detach(uint8_t pin);
+
+  // Detach all listeners, devices and ISRs.
+  static void reset();
+};
+
+#endif /* I2C_PARALLEL_SIM_BOARD_H */
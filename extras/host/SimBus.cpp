@@ -0,0 +1,166 @@
+// (c) Copyright 2026 Aaron Kimball
+// This library is licensed under the terms of the BSD 3-Clause license.
+// See the accompanying LICENSE.txt file for full license text.
+
+#include <algorithm>
+#include <cstring>
+
+#include "SimBoard.h"
+#include "SimBus.h"
+
+SimBus::SimBus()
+    : _active(nullptr), _held(false), _clockHz(100000), _timeoutMicros(25000), _sdaHeldClocks(0),
+      _sclLevel(1) {
+  resetCounters();
+}
+
+void SimBus::connectPins(uint8_t sdaPin, uint8_t sclPin) {
+  SimGpio::setInputSource(sdaPin, [this]() -> uint8_t { return _sdaHeldClocks > 0 ? 0 : 1; });
+  SimGpio::setListener(sclPin, [this](uint8_t level) {
+    if (level != 0 && _sclLevel == 0 && _sdaHeldClocks > 0) {
+      _sdaHeldClocks--; // Rising edge: the stuck device shifts out one more bit.
+    }
+    _sclLevel = level;
+  });
+}
+
+void SimBus::timeout() {
+  _counters.timeouts++;
+  SimClock::advanceNanos(static_cast<uint64_t>(_timeoutMicros) * 1000ULL);
+  _held = false;
+  _active = nullptr;
+}
+
+void SimBus::attach(SimDevice* dev) { _devices.push_back(dev); }
+
+void SimBus::detach(SimDevice* dev) {
+  _devices.erase(std::remove(_devices.begin(), _devices.end(), dev), _devices.end());
+  if (_active == dev) {
+    _active = nullptr;
+  }
+}
+
+void SimBus::detachAll() {
+  _devices.clear();
+  _active = nullptr;
+  _held = false;
+}
+
+void SimBus::setClock(uint32_t hz) {
+  if (hz != _clockHz) {
+    _counters.clockChanges++;
+  }
+  _clockHz = hz;
+}
+
+void SimBus::resetCounters() { memset(&_counters, 0, sizeof(_counters)); }
+
+SimDevice* SimBus::find(uint8_t addr) {
+  for (SimDevice* dev : _devices) {
+    if (dev->address() == addr && dev->isPresent()) {
+      return dev;
+    }
+  }
+  return nullptr;
+}
+
+void SimBus::clock(uint32_t bits) {
+  uint64_t nanos = static_cast<uint64_t>(bits) * 1000000000ULL / _clockHz;
+  _counters.bitTimes += bits;
+  _counters.busNanos += nanos;
+  SimClock::advanceNanos(nanos);
+}
+
+void SimBus::start() {
+  if (_active != nullptr) {
+    // A repeated START ends the current device's transaction.
+    _active->onStop();
+    _active = nullptr;
+  }
+  _counters.starts++;
+  if (_held) {
+    _counters.repeatedStarts++;
+  }
+  clock(SIM_BITS_PER_START);
+}
+
+void SimBus::stop() {
+  if (_active != nullptr) {
+    _active->onStop();
+    _active = nullptr;
+  }
+  _counters.stops++;
+  _held = false;
+  clock(SIM_BITS_PER_STOP);
+}
+
+uint8_t SimBus::masterWrite(uint8_t addr, const uint8_t* data, size_t len, bool sendStop) {
+  if (_sdaHeldClocks > 0) {
+    timeout();
+    return SIM_BUS_TIMEOUT;
+  }
+  uint8_t status = SIM_BUS_OK;
+  start();
+  _counters.addrBytes++;
+  clock(SIM_BITS_PER_BYTE);
+
+  SimDevice* dev = find(addr);
+  if (dev == nullptr || !dev->onAddress(false)) {
+    _counters.nacks++;
+    status = SIM_BUS_ADDR_NACK;
+  } else {
+    _active = dev;
+    for (size_t i = 0; i < len; i++) {
+      _counters.bytesWritten++;
+      clock(SIM_BITS_PER_BYTE);
+      if (!dev->onWrite(data[i])) {
+        _counters.nacks++;
+        status = SIM_BUS_DATA_NACK;
+        break;
+      }
+    }
+  }
+
+  // A NACK always makes the master abort with a STOP.
+  if (sendStop || status != SIM_BUS_OK) {
+    stop();
+  } else {
+    _held = true;
+  }
+  SimGpio::refresh();
+  return status;
+}
+
+size_t SimBus::masterRead(uint8_t addr, uint8_t* buf, size_t len, bool sendStop) {
+  if (_sdaHeldClocks > 0) {
+    timeout();
+    return 0;
+  }
+  size_t numRead = 0;
+  start();
+  _counters.addrBytes++;
+  clock(SIM_BITS_PER_BYTE);
+
+  SimDevice* dev = find(addr);
+  if (dev == nullptr || !dev->onAddress(true)) {
+    _counters.nacks++;
+    stop();
+    SimGpio::refresh();
+    return 0;
+  }
+
+  _active = dev;
+  for (; numRead < len; numRead++) {
+    _counters.bytesRead++;
+    clock(SIM_BITS_PER_BYTE);
+    buf[numRead] = dev->onRead();
+  }
+
+  if (sendStop) {
+    stop();
+  } else {
+    _held = true;
+  }
+  SimGpio::refresh();
+  return numRead;
+}
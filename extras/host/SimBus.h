@@ -0,0 +1,136 @@
+// (c) Copyright 2026 Aaron Kimball
+// This library is licensed under the terms of the BSD 3-Clause license.
+// See the accompanying LICENSE.txt file for full license text.
+//
+// Simulated I2C bus. Each TwoWire instance in the host build drives one SimBus,
+// which routes transactions to attached SimDevice models and counts what went
+// over the wire.
+//
+// Bus time is modeled in SCL bit periods: each START (or repeated START) and
+// each STOP costs one bit period, and each byte costs nine (eight data bits
+// plus the ACK/NACK bit). The simulated clock advances by that amount at the
+// bus' current clock rate on every transaction.
+
+#ifndef I2C_PARALLEL_SIM_BUS_H
+#define I2C_PARALLEL_SIM_BUS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Status codes returned by masterWrite(); these match TwoWire::endTransmission().
+static constexpr uint8_t SIM_BUS_OK = 0;
+static constexpr uint8_t SIM_BUS_DATA_TOO_LONG = 1;
+static constexpr uint8_t SIM_BUS_ADDR_NACK = 2;
+static constexpr uint8_t SIM_BUS_DATA_NACK = 3;
+static constexpr uint8_t SIM_BUS_TIMEOUT = 5;
+
+static constexpr uint32_t SIM_BITS_PER_BYTE = 9;
+static constexpr uint32_t SIM_BITS_PER_START = 1;
+static constexpr uint32_t SIM_BITS_PER_STOP = 1;
+
+/** Traffic counters for a SimBus. */
+struct SimBusCounters {
+  uint32_t starts;         // START conditions, including repeated STARTs.
+  uint32_t repeatedStarts; // Repeated STARTs (START with no preceding STOP).
+  uint32_t stops;          // STOP conditions.
+  uint32_t addrBytes;      // Address bytes clocked out by the master.
+  uint32_t bytesWritten;   // Data bytes written by the master.
+  uint32_t bytesRead;      // Data bytes read by the master.
+  uint32_t nacks;          // Address or data bytes NACKed by a device.
+  uint32_t timeouts;       // Transactions that timed out on a stuck bus.
+  uint32_t clockChanges;   // Calls to setClock() that changed the clock rate.
+  uint64_t bitTimes;       // Total SCL bit periods used.
+  uint64_t busNanos;       // Total modeled bus time at the clock rate in effect.
+
+  uint32_t totalBytes() const { return addrBytes + bytesWritten + bytesRead; }
+
+  // Modeled bus time for this traffic if it had all run at `hz`.
+  double microsAt(uint32_t hz) const { return bitTimes * 1.0e6 / hz; }
+};
+
+/**
+ * Base class for simulated I2C devices. Subclasses override the hooks they
+ * need; the defaults model a device that ACKs everything and reads as 0xFF.
+ */
+class SimDevice {
+public:
+  explicit SimDevice(uint8_t addr) : _addr(addr), _present(true){};
+  virtual ~SimDevice(){};
+
+  uint8_t address() const { return _addr; };
+
+  // Remove the device from the bus electrically; it will NACK its address.
+  void setPresent(bool present) { _present = present; };
+  bool isPresent() const { return _present; };
+
+  // The device has been addressed. Return true to ACK.
+  virtual bool onAddress(bool read) { return true; };
+  // The master has written a byte. Return true to ACK.
+  virtual bool onWrite(uint8_t val) { return true; };
+  // The master is clocking in a byte.
+  virtual uint8_t onRead() { return 0xFF; };
+  // The transaction addressed to this device has ended (STOP or repeated START).
+  virtual void onStop(){};
+
+  // Current state of the device's INT_L output (true = pulled low).
+  virtual bool intAsserted() const { return false; };
+
+private:
+  const uint8_t _addr;
+  bool _present;
+};
+
+class SimBus {
+public:
+  SimBus();
+
+  void attach(SimDevice* dev);
+  void detach(SimDevice* dev);
+  void detachAll();
+
+  void setClock(uint32_t hz);
+  uint32_t getClock() const { return _clockHz; };
+
+  // Master write transaction: START, address+W, `len` data bytes, and a STOP
+  // if `sendStop` is true. Returns one of the SIM_BUS_* status codes.
+  uint8_t masterWrite(uint8_t addr, const uint8_t* data, size_t len, bool sendStop);
+
+  // Master read transaction. Returns the number of bytes read; 0 if the address
+  // was NACKed.
+  size_t masterRead(uint8_t addr, uint8_t* buf, size_t len, bool sendStop);
+
+  // Transactions on a stuck bus fail after this long.
+  void setTimeoutMicros(uint32_t micros) { _timeoutMicros = micros; };
+  uint32_t getTimeoutMicros() const { return _timeoutMicros; };
+
+  // Wire the bus lines to MCU GPIO pins, for bus recovery: SDA reads back its
+  // level and SCL pulses clock a stuck device.
+  void connectPins(uint8_t sdaPin, uint8_t sclPin);
+
+  // Model a device that lost sync mid-byte: it holds SDA low for the next
+  // `numClocks` SCL pulses. Until then every transaction times out.
+  void holdSda(uint8_t numClocks) { _sdaHeldClocks = numClocks; };
+  bool isSdaHeld() const { return _sdaHeldClocks > 0; };
+
+  const SimBusCounters& counters() const { return _counters; };
+  void resetCounters();
+
+private:
+  SimDevice* find(uint8_t addr);
+  void start();
+  void stop();
+  void clock(uint32_t bits);
+  void timeout();
+
+  std::vector<SimDevice*> _devices;
+  SimDevice* _active; // Device addressed in the current (unstopped) transaction.
+  bool _held;         // Last transaction ended without a STOP.
+  uint32_t _clockHz;
+  uint32_t _timeoutMicros;
+  uint8_t _sdaHeldClocks;
+  uint8_t _sclLevel;
+  SimBusCounters _counters;
+};
+
+#endif /* I2C_PARALLEL_SIM_BUS_H */
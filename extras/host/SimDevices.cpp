@@ -0,0 +1,236 @@
+// (c) Copyright 2026 Aaron Kimball
+// This library is licensed under the terms of the BSD 3-Clause license.
+// See the accompanying LICENSE.txt file for full license text.
+
+#include <Arduino.h>
+
+#include "SimBoard.h"
+#include "SimDevices.h"
+
+static constexpr uint8_t POWER_ON_PORT = 0xFF;
+static constexpr uint8_t POWER_ON_POLARITY = 0x00;
+static constexpr uint8_t REG_POINTER_MASK = 0x03;
+
+SimPCF8574::SimPCF8574(uint8_t addr)
+    : SimDevice(addr), _latch(POWER_ON_PORT), _external(POWER_ON_PORT), _snapshot(POWER_ON_PORT),
+      _latchCount(0) {}
+
+bool SimPCF8574::onWrite(uint8_t val) {
+  _latch = val;
+  _latchCount++;
+  _snapshot = pins();
+  return true;
+}
+
+uint8_t SimPCF8574::onRead() {
+  _snapshot = pins();
+  return _snapshot;
+}
+
+void SimPCF8574::setInputs(uint8_t levels) {
+  _external = levels;
+  SimGpio::refresh();
+}
+
+SimPCA9534::SimPCA9534(uint8_t addr) : SimDevice(addr), _external(POWER_ON_PORT), _latchCount(0) {
+  powerOnReset();
+}
+
+void SimPCA9534::powerOnReset() {
+  _ptr = REG_INPUT;
+  _expectCommand = false;
+  _output = POWER_ON_PORT;
+  _polarity = POWER_ON_POLARITY;
+  _config = POWER_ON_PORT;
+  _snapshot = pins();
+}
+
+bool SimPCA9534::onAddress(bool read) {
+  if (!read) {
+    _expectCommand = true;
+  }
+  return true;
+}
+
+bool SimPCA9534::onWrite(uint8_t val) {
+  if (_expectCommand) {
+    _ptr = val & REG_POINTER_MASK;
+    _expectCommand = false;
+  } else {
+    if (_writeHook) {
+      _writeHook(_ptr, val);
+    }
+    writeRegister(_ptr, val);
+  }
+  return true;
+}
+
+uint8_t SimPCA9534::onRead() { return readRegister(_ptr); }
+
+uint8_t SimPCA9534::readRegister(uint8_t reg) {
+  switch (reg) {
+  case REG_INPUT:
+    _snapshot = pins();
+    return inputReg();
+  case REG_OUTPUT:
+    return _output;
+  case REG_POLARITY:
+    return _polarity;
+  case REG_CONFIG:
+  default:
+    return _config;
+  }
+}
+
+void SimPCA9534::writeRegister(uint8_t reg, uint8_t val) {
+  switch (reg) {
+  case REG_OUTPUT:
+    _output = val;
+    _latchCount++;
+    break;
+  case REG_POLARITY:
+    _polarity = val;
+    break;
+  case REG_CONFIG:
+    _config = val;
+    break;
+  case REG_INPUT:
+  default:
+    break; // Writes to the INPUT register have no effect.
+  }
+}
+
+bool SimPCA9534::intAsserted() const { return ((pins() ^ _snapshot) & _config) != 0; }
+
+void SimPCA9534::setInputs(uint8_t levels) {
+  _external = levels;
+  if (_ptr == REG_INPUT) {
+    // Interrupt errata: the change is absorbed while the pointer is on INPUT.
+    _snapshot = pins();
+  }
+  SimGpio::refresh();
+}
+
+SimPCA9538::SimPCA9538(uint8_t addr, uint8_t resetPin)
+    : SimPCA9534(addr), _inReset(false), _resetCount(0) {
+  SimGpio::setListener(resetPin, [this](uint8_t level) {
+    if (level == LOW && !_inReset) {
+      _resetCount++;
+      powerOnReset();
+    }
+    _inReset = (level == LOW);
+  });
+}
+
+bool SimPCA9538::onAddress(bool read) {
+  if (_inReset) {
+    return false;
+  }
+  return SimPCA9534::onAddress(read);
+}
+
+SimTCAL6408::SimTCAL6408(uint8_t addr, uint8_t resetPin) : SimPCA9538(addr, resetPin) {
+  resetAgile();
+}
+
+void SimTCAL6408::resetAgile() {
+  _drive[0] = POWER_ON_PORT;
+  _drive[1] = POWER_ON_PORT;
+  _inputLatch = 0x00;
+  _pullEnable = 0x00;
+  _pullSelect = POWER_ON_PORT;
+  _intMask = POWER_ON_PORT;
+  _outputConfig = 0x00;
+  _latched = 0x00;
+  _latchedValue = 0x00;
+}
+
+void SimTCAL6408::powerOnReset() {
+  SimPCA9538::powerOnReset();
+  resetAgile();
+}
+
+bool SimTCAL6408::onWrite(uint8_t val) {
+  if (_expectCommand) {
+    _ptr = val; // The full command byte selects a register.
+    _expectCommand = false;
+  } else {
+    if (_writeHook) {
+      _writeHook(_ptr, val);
+    }
+    writeRegister(_ptr, val);
+  }
+  return true;
+}
+
+uint8_t SimTCAL6408::intStatus() const {
+  const uint8_t live = (pins() ^ _snapshot) & _config & ~_inputLatch;
+  return (live | _latched) & ~_intMask;
+}
+
+void SimTCAL6408::setInputs(uint8_t levels) {
+  _external = levels;
+  // A latched pin holds the first change after the last INPUT read.
+  const uint8_t newlyLatched = (pins() ^ _snapshot) & _config & _inputLatch & ~_latched;
+  _latched |= newlyLatched;
+  _latchedValue = (_latchedValue & ~newlyLatched) | (pins() & newlyLatched);
+  SimGpio::refresh();
+}
+
+uint8_t SimTCAL6408::readRegister(uint8_t reg) {
+  switch (reg) {
+  case REG_INPUT: {
+    const uint8_t val = ((pins() & ~_latched) | (_latchedValue & _latched)) ^ _polarity;
+    _snapshot = pins();
+    _latched = 0x00;
+    return val;
+  }
+  case REG_DRIVE_0:
+  case REG_DRIVE_1:
+    return _drive[reg - REG_DRIVE_0];
+  case REG_INPUT_LATCH:
+    return _inputLatch;
+  case REG_PULL_ENABLE:
+    return _pullEnable;
+  case REG_PULL_SELECT:
+    return _pullSelect;
+  case REG_INT_MASK:
+    return _intMask;
+  case REG_INT_STATUS:
+    return intStatus();
+  case REG_OUTPUT_CONFIG:
+    return _outputConfig;
+  default:
+    return SimPCA9538::readRegister(reg);
+  }
+}
+
+void SimTCAL6408::writeRegister(uint8_t reg, uint8_t val) {
+  switch (reg) {
+  case REG_DRIVE_0:
+  case REG_DRIVE_1:
+    _drive[reg - REG_DRIVE_0] = val;
+    break;
+  case REG_INPUT_LATCH:
+    _inputLatch = val;
+    _latched &= val;
+    break;
+  case REG_PULL_ENABLE:
+    _pullEnable = val;
+    break;
+  case REG_PULL_SELECT:
+    _pullSelect = val;
+    break;
+  case REG_INT_MASK:
+    _intMask = val;
+    break;
+  case REG_OUTPUT_CONFIG:
+    _outputConfig = val;
+    break;
+  case REG_INT_STATUS:
+    break; // Read-only.
+  default:
+    SimPCA9538::writeRegister(reg, val);
+    break;
+  }
+}
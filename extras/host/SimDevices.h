@@ -0,0 +1,193 @@
+// (c) Copyright 2026 Aaron Kimball
+// This library is licensed under the terms of the BSD 3-Clause license.
+// See the accompanying LICENSE.txt file for full license text.
+//
+// Register-level models of the bus expanders supported by I2CParallel2, for use
+// with the simulated I2C bus in the host build.
+
+#ifndef I2C_PARALLEL_SIM_DEVICES_H
+#define I2C_PARALLEL_SIM_DEVICES_H
+
+#include <cstdint>
+#include <functional>
+
+#include "SimBus.h"
+
+/**
+ * PCF8574 / PCF8574A: a single quasi-bidirectional port. Every data byte
+ * written is latched onto the port; every byte read is a fresh sample of the
+ * pins. A pin reads low if the latch drives it low or if an external source
+ * pulls it low. INT_L is asserted while the pins differ from their state at
+ * the last port read or write.
+ */
+class SimPCF8574 : public SimDevice {
+public:
+  // External circuit whose pull-downs depend on the pin levels, e.g. a key
+  // matrix: given the levels the port would have without it, returns the
+  // levels it drives (as for setInputs()).
+  typedef std::function<uint8_t(uint8_t levels)> Load;
+
+  explicit SimPCF8574(uint8_t addr);
+
+  virtual bool onWrite(uint8_t val) override;
+  virtual uint8_t onRead() override;
+  virtual bool intAsserted() const override { return pins() != _snapshot; };
+
+  // Set the levels driven onto the port by external logic. 1 bits let the pin
+  // float (it then follows the latch); 0 bits pull the pin low.
+  void setInputs(uint8_t levels);
+  void setLoad(Load load) { _load = load; };
+
+  uint8_t latch() const { return _latch; };
+  uint8_t pins() const {
+    const uint8_t levels = _latch & _external;
+    return _load ? levels & _load(levels) : levels;
+  };
+  // Number of data bytes latched onto the port since construction.
+  uint32_t latchCount() const { return _latchCount; };
+
+private:
+  uint8_t _latch;
+  uint8_t _external;
+  uint8_t _snapshot;
+  uint32_t _latchCount;
+  Load _load;
+};
+
+/**
+ * PCA9534 / PCA9554 and the TCA variants: INPUT, OUTPUT, POLARITY and CONFIG
+ * registers behind a register pointer. The first byte of each write sets the
+ * pointer; further bytes in the same transaction all overwrite the register it
+ * selects (the pointer does not auto-increment). Reads return the selected
+ * register repeatedly.
+ *
+ * INT_L is asserted while the input pins differ from their state at the last
+ * INPUT register read. This model also reproduces the TI interrupt errata:
+ * input changes that happen while the pointer rests on the INPUT register are
+ * absorbed without asserting INT_L.
+ */
+class SimPCA9534 : public SimDevice {
+public:
+  static constexpr uint8_t REG_INPUT = 0x00;
+  static constexpr uint8_t REG_OUTPUT = 0x01;
+  static constexpr uint8_t REG_POLARITY = 0x02;
+  static constexpr uint8_t REG_CONFIG = 0x03;
+
+  // Observer of register writes: called with the register and data byte of
+  // each write, before the write takes effect.
+  typedef std::function<void(uint8_t reg, uint8_t val)> WriteHook;
+
+  explicit SimPCA9534(uint8_t addr);
+
+  virtual bool onAddress(bool read) override;
+  virtual bool onWrite(uint8_t val) override;
+  virtual uint8_t onRead() override;
+  virtual bool intAsserted() const override;
+
+  // Set the levels driven onto pins configured as inputs.
+  void setInputs(uint8_t levels);
+  // As SimPCF8574::setLoad(); only pins configured as inputs are affected.
+  void setLoad(SimPCF8574::Load load) { _load = load; };
+  void setWriteHook(WriteHook hook) { _writeHook = hook; };
+
+  // Restore power-on register defaults.
+  virtual void powerOnReset();
+
+  uint8_t pins() const {
+    const uint8_t levels = (_output & ~_config) | (_external & _config);
+    return _load ? levels & (_load(levels) | ~_config) : levels;
+  };
+  uint8_t inputReg() const { return pins() ^ _polarity; };
+  uint8_t outputReg() const { return _output; };
+  uint8_t configReg() const { return _config; };
+  uint8_t polarityReg() const { return _polarity; };
+  uint8_t pointer() const { return _ptr; };
+  // Number of bytes written into the OUTPUT register since construction.
+  uint32_t latchCount() const { return _latchCount; };
+
+protected:
+  virtual uint8_t readRegister(uint8_t reg);
+  virtual void writeRegister(uint8_t reg, uint8_t val);
+
+  uint8_t _ptr;
+  bool _expectCommand;
+  uint8_t _output;
+  uint8_t _polarity;
+  uint8_t _config;
+  uint8_t _external;
+  uint8_t _snapshot;
+  uint32_t _latchCount;
+  SimPCF8574::Load _load;
+  WriteHook _writeHook;
+};
+
+/**
+ * PCA9538 / TCA6408A: a '9534 with an active-low RESET_L input wired to an MCU
+ * GPIO pin. Driving the pin low restores power-on defaults and holds the device
+ * off the bus until the pin is released.
+ */
+class SimPCA9538 : public SimPCA9534 {
+public:
+  SimPCA9538(uint8_t addr, uint8_t resetPin);
+
+  virtual bool onAddress(bool read) override;
+
+  uint32_t resetCount() const { return _resetCount; };
+
+private:
+  bool _inReset;
+  uint32_t _resetCount;
+};
+
+/**
+ * TCAL6408: a '6408A with the agile I/O registers at 0x40--0x4F. Input
+ * latching, interrupt masking and the interrupt status register are modeled;
+ * the drive strength, pull resistor and output configuration registers are
+ * stored but do not affect the pins. This part does not have the '9534
+ * interrupt errata. All pins are interrupt-masked at power-on.
+ */
+class SimTCAL6408 : public SimPCA9538 {
+public:
+  static constexpr uint8_t REG_DRIVE_0 = 0x40;
+  static constexpr uint8_t REG_DRIVE_1 = 0x41;
+  static constexpr uint8_t REG_INPUT_LATCH = 0x42;
+  static constexpr uint8_t REG_PULL_ENABLE = 0x43;
+  static constexpr uint8_t REG_PULL_SELECT = 0x44;
+  static constexpr uint8_t REG_INT_MASK = 0x45;
+  static constexpr uint8_t REG_INT_STATUS = 0x46;
+  static constexpr uint8_t REG_OUTPUT_CONFIG = 0x4F;
+
+  SimTCAL6408(uint8_t addr, uint8_t resetPin);
+
+  virtual bool onWrite(uint8_t val) override;
+  virtual bool intAsserted() const override { return intStatus() != 0; };
+  virtual void powerOnReset() override;
+
+  void setInputs(uint8_t levels);
+
+  uint8_t intStatus() const;
+  uint8_t driveReg(uint8_t half) const { return _drive[half & 1]; };
+  uint8_t inputLatchReg() const { return _inputLatch; };
+  uint8_t pullEnableReg() const { return _pullEnable; };
+  uint8_t pullSelectReg() const { return _pullSelect; };
+  uint8_t intMaskReg() const { return _intMask; };
+  uint8_t outputConfigReg() const { return _outputConfig; };
+
+protected:
+  virtual uint8_t readRegister(uint8_t reg) override;
+  virtual void writeRegister(uint8_t reg, uint8_t val) override;
+
+private:
+  void resetAgile();
+
+  uint8_t _drive[2];
+  uint8_t _inputLatch;
+  uint8_t _pullEnable;
+  uint8_t _pullSelect;
+  uint8_t _intMask;
+  uint8_t _outputConfig;
+  uint8_t _latched;      // Latched pins with a change held for the next INPUT read.
+  uint8_t _latchedValue; // Pin values captured by those latches.
+};
+
+#endif /* I2C_PARALLEL_SIM_DEVICES_H */
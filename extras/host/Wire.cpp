@@ -0,0 +1,62 @@
+// (c) Copyright 2026 Aaron Kimball
+// This library is licensed under the terms of the BSD 3-Clause license.
+// See the accompanying LICENSE.txt file for full license text.
+
+#include <Wire.h>
+
+TwoWire Wire;
+TwoWire Wire1;
+
+TwoWire::TwoWire() : _txAddr(0), _txLen(0), _transmitting(false), _rxLen(0), _rxPos(0) {}
+
+void TwoWire::beginTransmission(uint8_t address) {
+  _txAddr = address;
+  _txLen = 0;
+  _transmitting = true;
+}
+
+size_t TwoWire::write(uint8_t data) {
+  if (!_transmitting || _txLen >= BUFFER_LENGTH) {
+    return 0;
+  }
+  _txBuf[_txLen++] = data;
+  return 1;
+}
+
+size_t TwoWire::write(const uint8_t* data, size_t quantity) {
+  size_t numWritten = 0;
+  while (numWritten < quantity && write(data[numWritten]) == 1) {
+    numWritten++;
+  }
+  return numWritten;
+}
+
+uint8_t TwoWire::endTransmission(uint8_t sendStop) {
+  uint8_t status = _bus.masterWrite(_txAddr, _txBuf, _txLen, sendStop != 0);
+  _txLen = 0;
+  _transmitting = false;
+  return status;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity, uint8_t sendStop) {
+  if (quantity > BUFFER_LENGTH) {
+    quantity = BUFFER_LENGTH;
+  }
+  _rxLen = static_cast<uint8_t>(_bus.masterRead(address, _rxBuf, quantity, sendStop != 0));
+  _rxPos = 0;
+  return _rxLen;
+}
+
+int TwoWire::read() {
+  if (_rxPos >= _rxLen) {
+    return -1;
+  }
+  return _rxBuf[_rxPos++];
+}
+
+int TwoWire::peek() {
+  if (_rxPos >= _rxLen) {
+    return -1;
+  }
+  return _rxBuf[_rxPos];
+}
@@ -0,0 +1,63 @@
+// (c) Copyright 2026 Aaron Kimball
+// This library is licensed under the terms of the BSD 3-Clause license.
+// See the accompanying LICENSE.txt file for full license text.
+//
+// Host-side stand-in for the Arduino <Wire.h> library. Each TwoWire instance
+// forwards its transactions to a simulated I2C bus (see SimBus.h).
+
+#ifndef I2C_PARALLEL_HOST_WIRE_H
+#define I2C_PARALLEL_HOST_WIRE_H
+
+#include <Arduino.h>
+
+#include "SimBus.h"
+
+// Size of the TX and RX buffers, as in the AVR Wire library.
+#define BUFFER_LENGTH 32
+
+class TwoWire {
+public:
+  TwoWire();
+
+  void begin(){};
+  void end(){};
+  void setClock(uint32_t clock) { _bus.setClock(clock); };
+  void setWireTimeout(uint32_t timeout = 25000, bool resetWithTimeout = false) {
+    _bus.setTimeoutMicros(timeout);
+  };
+  void setTimeout(uint32_t timeout){};
+
+  void beginTransmission(uint8_t address);
+  void beginTransmission(int address) { beginTransmission(static_cast<uint8_t>(address)); };
+  uint8_t endTransmission(uint8_t sendStop = true);
+
+  uint8_t requestFrom(uint8_t address, uint8_t quantity, uint8_t sendStop = true);
+  uint8_t requestFrom(int address, int quantity, int sendStop = true) {
+    return requestFrom(static_cast<uint8_t>(address), static_cast<uint8_t>(quantity),
+        static_cast<uint8_t>(sendStop));
+  };
+
+  size_t write(uint8_t data);
+  size_t write(const uint8_t* data, size_t quantity);
+  int available() { return _rxLen - _rxPos; };
+  int read();
+  int peek();
+
+  // The simulated bus behind this controller.
+  SimBus& bus() { return _bus; };
+
+private:
+  SimBus _bus;
+  uint8_t _txAddr;
+  uint8_t _txBuf[BUFFER_LENGTH];
+  uint8_t _txLen;
+  bool _transmitting;
+  uint8_t _rxBuf[BUFFER_LENGTH];
+  uint8_t _rxLen;
+  uint8_t _rxPos;
+};
+
+extern TwoWire Wire;
+extern TwoWire Wire1;
+
+#endif /* I2C_PARALLEL_HOST_WIRE_H */
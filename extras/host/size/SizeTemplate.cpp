@@ -0,0 +1,45 @@
+// (c) Copyright 2026 Aaron Kimball
+// This library is licensed under the terms of the BSD 3-Clause license.
+// See the accompanying LICENSE.txt file for full license text.
+//
+// Code size comparison: 8 devices through the I2CParallelT templates.
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <cstdio>
+
+#include "I2CParallelT.h"
+
+typedef I2CParallelT<I2CParallelChip8574> Pcf8574;
+typedef I2CParallelT<I2CParallelChip9534> Pca9534;
+
+Pcf8574 pcf[4] = { Pcf8574(Wire), Pcf8574(Wire), Pcf8574(Wire), Pcf8574(Wire) };
+Pca9534 pca[4] = { Pca9534(Wire), Pca9534(Wire), Pca9534(Wire), Pca9534(Wire) };
+
+int main() {
+  pcf[0].init<I2C_PCF8574_MIN_ADDR + 0>();
+  pcf[1].init<I2C_PCF8574_MIN_ADDR + 1>();
+  pcf[2].init<I2C_PCF8574_MIN_ADDR + 2>();
+  pcf[3].init<I2C_PCF8574_MIN_ADDR + 3>();
+  pca[0].init<I2C_PCA9534A_MIN_ADDR + 0>();
+  pca[1].init<I2C_PCA9534A_MIN_ADDR + 1>();
+  pca[2].init<I2C_PCA9534A_MIN_ADDR + 2>();
+  pca[3].init<I2C_PCA9534A_MIN_ADDR + 3>();
+  for (uint8_t i = 0; i < 4; i++) {
+    pca[i].enableInputs(0xF0);
+  }
+  unsigned sum = 0;
+  for (uint8_t n = 0; n < 10; n++) {
+    for (uint8_t i = 0; i < 4; i++) {
+      pcf[i].setBit(n & 7);
+      pcf[i].waitForValid();
+      sum += pcf[i].getByte();
+      pca[i].toggleBit(n & 3);
+      pca[i].waitForValid();
+      sum += pca[i].getByte();
+    }
+  }
+  printf("template: sizeof(Pcf8574)=%zu sizeof(Pca9534)=%zu devices=%zu bytes\n", sizeof(Pcf8574),
+      sizeof(Pca9534), sizeof(pcf) + sizeof(pca));
+  return sum == 0;
+}
@@ -0,0 +1,36 @@
+// (c) Copyright 2026 Aaron Kimball
+// This library is licensed under the terms of the BSD 3-Clause license.
+// See the accompanying LICENSE.txt file for full license text.
+//
+// Code size comparison: 8 devices through the virtual I2CParallel classes.
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <cstdio>
+
+#include "I2CParallel2.h"
+
+I2CParallel8574 pcf[4];
+I2CParallel9534 pca[4];
+
+int main() {
+  for (uint8_t i = 0; i < 4; i++) {
+    pcf[i].init(I2C_PCF8574_MIN_ADDR + i);
+    pca[i].init(I2C_PCA9534A_MIN_ADDR + i);
+    pca[i].enableInputs(0xF0);
+  }
+  unsigned sum = 0;
+  for (uint8_t n = 0; n < 10; n++) {
+    for (uint8_t i = 0; i < 4; i++) {
+      pcf[i].setBit(n & 7);
+      pcf[i].waitForValid();
+      sum += static_cast<I2CParallel&>(pcf[i]).getByte();
+      pca[i].toggleBit(n & 3);
+      pca[i].waitForValid();
+      sum += static_cast<I2CParallel&>(pca[i]).getByte();
+    }
+  }
+  printf("virtual:  sizeof(I2CParallel8574)=%zu sizeof(I2CParallel9534)=%zu devices=%zu bytes\n",
+      sizeof(I2CParallel8574), sizeof(I2CParallel9534), sizeof(pcf) + sizeof(pca));
+  return sum == 0;
+}
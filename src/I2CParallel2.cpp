@@ -9,8 +9,381 @@
 
 #include "I2CParallel2.h"
 #include <Arduino.h>
+#include <Wire.h>
+
+// Largest read the Wire library can buffer in one requestFrom() call.
+#if defined(BUFFER_LENGTH)
+static constexpr size_t WIRE_RX_BUFFER_SIZE = BUFFER_LENGTH;
+#elif defined(I2C_BUFFER_LENGTH)
+static constexpr size_t WIRE_RX_BUFFER_SIZE = I2C_BUFFER_LENGTH;
+#else
+static constexpr size_t WIRE_RX_BUFFER_SIZE = 32;
+#endif
+
+// requestFrom() takes a uint8_t quantity.
+static constexpr size_t MAX_READ_CHUNK = (WIRE_RX_BUFFER_SIZE < 255) ? WIRE_RX_BUFFER_SIZE : 255;
+
+// SCL periods taken by a START condition and by each byte (8 data bits + ACK).
+static constexpr uint32_t SCL_PER_START = 1;
+static constexpr uint32_t SCL_PER_BYTE = 9;
+
+// _wire->endTransmission() status codes.
+static constexpr uint8_t WIRE_STATUS_OK = 0;
+static constexpr uint8_t WIRE_STATUS_DATA_TOO_LONG = 1;
+static constexpr uint8_t WIRE_STATUS_ADDR_NACK = 2;
+static constexpr uint8_t WIRE_STATUS_DATA_NACK = 3;
+static constexpr uint8_t WIRE_STATUS_OTHER = 4;
+static constexpr uint8_t WIRE_STATUS_TIMEOUT = 5;
+
+// Longest retry backoff; delayMicroseconds() is only accurate up to 16383 us on AVR.
+static constexpr uint16_t MAX_BACKOFF_MICROS = 16383;
+
+// Bus recovery clocks SCL at about 100 kHz.
+static constexpr uint8_t RECOVERY_CLOCKS = 9;
+static constexpr unsigned int RECOVERY_HALF_PERIOD_MICROS = 5;
+
+// Granularity of micros(): it may lag the true time by up to this much.
+#if defined(__AVR__) && F_CPU < 16000000L
+static constexpr uint32_t MICROS_RESOLUTION = 8;
+#elif defined(__AVR__)
+static constexpr uint32_t MICROS_RESOLUTION = 4;
+#else
+static constexpr uint32_t MICROS_RESOLUTION = 1;
+#endif
+
+// Teensyduino provides a cycle-counted delayNanoseconds().
+#if defined(TEENSYDUINO)
+#define I2C_PARALLEL_HAVE_DELAY_NANOS 1
+#endif
+
+#ifdef I2C_PARALLEL_ENABLE_STATS
+static void recordLatency(I2CParallelStats& stats, const uint8_t op, const uint32_t start) {
+  uint32_t elapsed = micros() - start;
+  uint8_t bucket = 0;
+  while (elapsed > 1 && bucket < I2C_PARALLEL_STATS_BUCKETS - 1) {
+    elapsed >>= 1;
+    bucket++;
+  }
+  if (stats.latency[op][bucket] != UINT16_MAX) {
+    stats.latency[op][bucket]++;
+  }
+}
+#endif /* I2C_PARALLEL_ENABLE_STATS */
 
 void I2CParallel::initInterrupt(const uint8_t digitalPinNum, void (*isr)()) {
   pinMode(digitalPinNum, INPUT_PULLUP);
   attachInterrupt(digitalPinToInterrupt(digitalPinNum), isr, FALLING);
+  _intPin = digitalPinNum;
+}
+
+uint8_t I2CParallel::endTransmission(const uint8_t op, const size_t nBytes, const bool sendStop) {
+  if (!allowAttempt()) {
+    // The circuit breaker is open; the buffered bytes are dropped unsent and
+    // discarded by the next beginTransmission().
+#ifdef I2C_PARALLEL_ENABLE_STATS
+    _stats.rejected++;
+#endif /* I2C_PARALLEL_ENABLE_STATS */
+    return WIRE_STATUS_OTHER;
+  }
+
+#ifdef I2C_PARALLEL_ENABLE_STATS
+  const uint32_t start = micros();
+  const uint8_t status = _wire->endTransmission(sendStop);
+  recordLatency(_stats, op, start);
+  _stats.transactions++;
+  switch (status) {
+  case WIRE_STATUS_OK:
+    _stats.bytesWritten += nBytes;
+    break;
+  case WIRE_STATUS_ADDR_NACK:
+    _stats.addrNacks++;
+    break;
+  case WIRE_STATUS_DATA_NACK:
+    _stats.dataNacks++;
+    break;
+  case WIRE_STATUS_TIMEOUT:
+    _stats.timeouts++;
+    break;
+  default:
+    _stats.otherErrors++;
+    break;
+  }
+#else
+  const uint8_t status = _wire->endTransmission(sendStop);
+#endif /* I2C_PARALLEL_ENABLE_STATS */
+
+  recordAttempt(status == WIRE_STATUS_OK);
+  if (status == WIRE_STATUS_OK && op != I2C_PARALLEL_OP_READ) {
+    startSettle(sendStop);
+  }
+  return status;
+}
+
+void I2CParallel::startSettle(const bool sendStop) {
+  // The STOP condition after the final ACK takes at least one SCL period,
+  // which counts toward the hold time.
+  const uint32_t stopNanos = (sendStop && _busSpeed > 0) ? 1000000000UL / _busSpeed : 0;
+  if (_holdNanos <= stopNanos) {
+    _settleNanos = 0;
+    return;
+  }
+  _settleNanos = _holdNanos - stopNanos;
+  _settleFromMicros = micros();
+}
+
+uint32_t I2CParallel::nanosSinceWrite() const {
+  const uint32_t elapsed = micros() - _settleFromMicros;
+  if (elapsed <= MICROS_RESOLUTION) {
+    return 0;
+  } else if (elapsed - MICROS_RESOLUTION > UINT16_MAX / 1000) {
+    return UINT16_MAX; // Longer than any hold time.
+  }
+  return (elapsed - MICROS_RESOLUTION) * 1000;
+}
+
+void I2CParallel::waitForValid() {
+  if (_settleNanos == 0) {
+    return;
+  }
+  const uint32_t elapsed = nanosSinceWrite();
+  if (elapsed < _settleNanos) {
+    const uint32_t remaining = _settleNanos - elapsed;
+#ifdef I2C_PARALLEL_HAVE_DELAY_NANOS
+    delayNanoseconds(remaining);
+#else
+    delayMicroseconds((remaining + 999) / 1000);
+#endif /* I2C_PARALLEL_HAVE_DELAY_NANOS */
+  }
+  _settleNanos = 0;
+}
+
+uint8_t I2CParallel::requestFromOnce(
+    const uint8_t op, const uint8_t quantity, const bool sendStop) {
+  if (!allowAttempt()) {
+#ifdef I2C_PARALLEL_ENABLE_STATS
+    _stats.rejected++;
+#endif /* I2C_PARALLEL_ENABLE_STATS */
+    return 0;
+  }
+
+#ifdef I2C_PARALLEL_ENABLE_STATS
+  const uint32_t start = micros();
+  const uint8_t numReceived = _wire->requestFrom(_i2cAddr, quantity, (uint8_t)sendStop);
+  recordLatency(_stats, op, start);
+  _stats.transactions++;
+  _stats.bytesRead += numReceived;
+  if (numReceived == 0 && quantity > 0) {
+    _stats.addrNacks++; // Wire reports an address NACK on read as 0 bytes received.
+  } else if (numReceived != quantity) {
+    _stats.otherErrors++;
+  }
+#else
+  const uint8_t numReceived = _wire->requestFrom(_i2cAddr, quantity, (uint8_t)sendStop);
+#endif /* I2C_PARALLEL_ENABLE_STATS */
+
+  recordAttempt(numReceived == quantity);
+  return numReceived;
+}
+
+uint8_t I2CParallel::requestFrom(const uint8_t op, const uint8_t quantity, const bool sendStop) {
+  const uint32_t start = micros();
+  uint16_t backoff = _retryPolicy->backoffMicros;
+  for (uint8_t attempt = 1;; attempt++) {
+    const uint8_t numReceived = requestFromOnce(op, quantity, sendStop);
+    // A read timeout is indistinguishable from a NACK through the Wire API.
+    if (numReceived == quantity || !retryAfter(attempt, start, backoff, false)) {
+      return numReceived;
+    }
+  }
+}
+
+uint8_t I2CParallel::transmit(
+    const uint8_t op, const uint8_t* data, const uint8_t n, const bool sendStop) {
+  const uint32_t start = micros();
+  uint16_t backoff = _retryPolicy->backoffMicros;
+  for (uint8_t attempt = 1;; attempt++) {
+    _wire->beginTransmission(_i2cAddr);
+    const size_t numWritten = _wire->write(data, n);
+    uint8_t status = endTransmission(op, numWritten, sendStop);
+    if (status == WIRE_STATUS_OK && numWritten != n) {
+      status = WIRE_STATUS_DATA_TOO_LONG;
+    }
+    if (status == WIRE_STATUS_OK
+        || !retryAfter(attempt, start, backoff, status == WIRE_STATUS_TIMEOUT)) {
+      return status;
+    }
+  }
+}
+
+bool I2CParallel::allowAttempt() {
+  if (!_breakerOpen) {
+    return true;
+  }
+  const uint32_t now = micros();
+  if (now - _breakerOpenedMicros < _retryPolicy->probeIntervalMicros) {
+    return false; // Fail fast.
+  }
+  // Let one probe through. If it fails, wait out another interval.
+  _breakerOpenedMicros = now;
+  return true;
+}
+
+void I2CParallel::recordAttempt(const bool ok) {
+  if (ok) {
+    _failedAttempts = 0;
+    _breakerOpen = false;
+    return;
+  }
+
+  if (_failedAttempts != UINT8_MAX) {
+    _failedAttempts++;
+  }
+  const uint8_t threshold = _retryPolicy->breakerThreshold;
+  if (!_breakerOpen && threshold != 0 && _failedAttempts >= threshold) {
+    _breakerOpen = true;
+    _breakerOpenedMicros = micros();
+  }
+}
+
+bool I2CParallel::retryAfter(
+    const uint8_t attempt, const uint32_t start, uint16_t& backoff, const bool timedOut) {
+  const I2CParallelRetryPolicy& policy = *_retryPolicy;
+  if (timedOut) {
+    recoverBus(); // A wedged bus blocks every device on it; free it even if not retrying.
+  }
+  if (attempt >= policy.maxAttempts || _breakerOpen) {
+    return false; // Out of attempts, or failing fast (including a failed probe).
+  }
+  if (policy.budgetMicros != 0 && micros() - start + backoff > policy.budgetMicros) {
+    return false;
+  }
+
+  if (backoff > 0) {
+    delayMicroseconds(backoff);
+    backoff = (backoff > MAX_BACKOFF_MICROS / 2) ? MAX_BACKOFF_MICROS : backoff * 2;
+  }
+#ifdef I2C_PARALLEL_ENABLE_STATS
+  _stats.retries++;
+#endif /* I2C_PARALLEL_ENABLE_STATS */
+  return true;
+}
+
+void I2CParallel::setRetryPolicy(const I2CParallelRetryPolicy& policy) {
+  _retryPolicy = &policy;
+  if (_i2cAddr != UNINITIALIZED_I2C_ADDR) {
+    applyWireTimeout();
+  }
+}
+
+void I2CParallel::applyWireTimeout() {
+#if defined(ARDUINO_ARCH_SAMD) || defined(ARDUINO_TEENSY41)
+  _wire->setTimeout(_retryPolicy->wireTimeoutMicros);
+#else
+  // Reset the Wire hardware on timeout; this is the default for the __ARCH_AVR__ Wire library.
+  _wire->setWireTimeout(_retryPolicy->wireTimeoutMicros, true);
+#endif
+}
+
+bool I2CParallel::recoverBus() {
+  const uint8_t sda = _retryPolicy->sdaPin;
+  const uint8_t scl = _retryPolicy->sclPin;
+  if (sda == INVALID_GPIO_PIN || scl == INVALID_GPIO_PIN) {
+    return false;
+  }
+
+  // Take the pins back from the I2C controller. SDA is only ever released
+  // (pulled up) or driven low, as an open-drain line.
+  _wire->end();
+  pinMode(sda, INPUT_PULLUP);
+  digitalWrite(scl, HIGH);
+  pinMode(scl, OUTPUT);
+
+  // A device that lost sync mid-byte is waiting to send the rest of its byte
+  // and an ACK bit: at most 9 clocks until it lets go of SDA.
+  for (uint8_t i = 0; i < RECOVERY_CLOCKS && digitalRead(sda) == LOW; i++) {
+    digitalWrite(scl, LOW);
+    delayMicroseconds(RECOVERY_HALF_PERIOD_MICROS);
+    digitalWrite(scl, HIGH);
+    delayMicroseconds(RECOVERY_HALF_PERIOD_MICROS);
+  }
+
+  // STOP: SDA rises while SCL is high.
+  digitalWrite(scl, LOW);
+  delayMicroseconds(RECOVERY_HALF_PERIOD_MICROS);
+  digitalWrite(sda, LOW);
+  pinMode(sda, OUTPUT);
+  delayMicroseconds(RECOVERY_HALF_PERIOD_MICROS);
+  digitalWrite(scl, HIGH);
+  delayMicroseconds(RECOVERY_HALF_PERIOD_MICROS);
+  pinMode(sda, INPUT_PULLUP);
+  delayMicroseconds(RECOVERY_HALF_PERIOD_MICROS);
+  const bool released = digitalRead(sda) == HIGH;
+  pinMode(scl, INPUT_PULLUP);
+
+  _wire->begin();
+  _wire->setClock(_busSpeed);
+  applyWireTimeout();
+#ifdef I2C_PARALLEL_ENABLE_STATS
+  _stats.recoveries++;
+#endif /* I2C_PARALLEL_ENABLE_STATS */
+  return released;
+}
+
+#ifdef I2C_PARALLEL_ENABLE_STATS
+void I2CParallel::resetStats() { memset(&_stats, 0, sizeof(_stats)); }
+#endif /* I2C_PARALLEL_ENABLE_STATS */
+
+void I2CParallel::beginUpdate() {
+  if (_updateDepth == 0) {
+    _updateBaseState = _outputState;
+  }
+  _updateDepth++;
+}
+
+size_t I2CParallel::commit() {
+  if (_updateDepth == 0) {
+    return 0; // No batch in progress.
+  } else if (--_updateDepth > 0) {
+    return 1; // Inner batch; the outermost commit() does the write.
+  }
+
+  const uint8_t val = _outputState;
+  if (val == _updateBaseState && isShadowValid(SHADOW_OUTPUT)) {
+    return 1; // Net change is zero; the device already holds this value.
+  }
+  // Restore the last-written state so setByte() sees the actual change.
+  _outputState = _updateBaseState;
+  return setByte(val);
+}
+
+size_t I2CParallel::readBurst(uint8_t* buf, const size_t n, uint32_t* timestamps) {
+  size_t numRead = 0;
+  while (numRead < n) {
+    size_t chunk = n - numRead;
+    if (chunk > MAX_READ_CHUNK) {
+      chunk = MAX_READ_CHUNK;
+    }
+
+    const uint32_t chunkStart = micros();
+    const size_t numReceived = requestFrom(I2C_PARALLEL_OP_READ, (uint8_t)chunk);
+    for (size_t i = 0; i < numReceived; i++) {
+      buf[numRead + i] = _wire->read();
+      if (timestamps != nullptr) {
+        // Each sample is latched as the ACK of the preceding byte is clocked.
+        const uint64_t sclPeriods = SCL_PER_START + SCL_PER_BYTE * (i + 1);
+        timestamps[numRead + i] = chunkStart + (uint32_t)(sclPeriods * 1000000ULL / _busSpeed);
+      }
+    }
+    numRead += numReceived;
+
+    if (numReceived != chunk) {
+      _error = I2C_PARALLEL_ERR_BUS_IO;
+      break;
+    }
+  }
+
+  if (numRead > 0) {
+    _inputState = buf[numRead - 1];
+  }
+  return numRead;
 }
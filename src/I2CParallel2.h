@@ -11,6 +11,9 @@
 #define I2C_PARALLEL2_H
 
 #include <Arduino.h>
+#include <Wire.h>
+
+#include "I2CParallel9534Regs.h"
 
 // An "i2c address" that no PCF8574[A] can have. We use this to note that
 // the device driver has not been initialized, and disable I/O until this
@@ -37,6 +40,8 @@ static constexpr uint8_t I2C_PCA9534A_MIN_ADDR = 0x38; // 0111xxx
 static constexpr uint8_t I2C_PCA9534A_MAX_ADDR = 0x3F;
 static constexpr uint8_t I2C_PCA9538_MIN_ADDR = 0x70; // 11100xx
 static constexpr uint8_t I2C_PCA9538_MAX_ADDR = 0x73;
+static constexpr uint8_t I2C_TCAL6408_MIN_ADDR = 0x20; // 010000x
+static constexpr uint8_t I2C_TCAL6408_MAX_ADDR = 0x21;
 
 static constexpr uint32_t I2C_SPEED_FAST = 400000L;
 static constexpr uint32_t I2C_SPEED_STANDARD = 100000L;
@@ -71,6 +76,243 @@ static constexpr uint8_t I2C_PARALLEL_ERR_CARRY =
 static constexpr uint8_t I2C_PARALLEL_ERR_INVALID_PIN =
     6; // Invalid GPIO pin used for the last operation.
 
+// INT_L pin modes for I2CParallel9534::setIntPinMode():
+
+// Apply the interrupt errata workaround only if initInterrupt() was called.
+static constexpr uint8_t I2C_PARALLEL_INT_AUTO = 0;
+// INT_L is not used. Leave the register pointer parked on the input register so
+// repeated getByte() calls are a single bus read each.
+static constexpr uint8_t I2C_PARALLEL_INT_NONE = 1;
+// INT_L is in use (e.g. by an ISR attached outside this library). Always apply
+// the interrupt errata workaround after reading the input register.
+static constexpr uint8_t I2C_PARALLEL_INT_CONNECTED = 2;
+
+// Output drive strengths for I2CParallelTCAL6408::setDriveStrength(), as a
+// fraction of the full drive current.
+static constexpr uint8_t I2C_PARALLEL_DRIVE_0_25X = 0;
+static constexpr uint8_t I2C_PARALLEL_DRIVE_0_5X = 1;
+static constexpr uint8_t I2C_PARALLEL_DRIVE_0_75X = 2;
+static constexpr uint8_t I2C_PARALLEL_DRIVE_1X = 3; // Power-on default.
+
+// Default Wire bus timeout set by init(), in microseconds.
+static constexpr uint32_t I2C_PARALLEL_WIRE_TIMEOUT = 25000;
+
+/**
+ * Retry, timeout and circuit breaker settings for I2CParallel::setRetryPolicy().
+ *
+ * A failed bus transaction is retried, after a backoff delay that doubles each
+ * time, until it succeeds, `maxAttempts` attempts have been made, or the next
+ * retry would start more than `budgetMicros` after the first attempt. One
+ * driver call therefore spends at most about budgetMicros + wireTimeoutMicros
+ * on each transaction it makes.
+ *
+ * After `breakerThreshold` consecutive failed attempts, the device's circuit
+ * breaker opens: transactions fail immediately, without touching the bus,
+ * except for a single probe attempt every `probeIntervalMicros`. The first
+ * successful attempt closes the breaker again.
+ *
+ * The buffered transactions of setBytes() are not retried, to keep the
+ * waveform timing intact, but they do respect the circuit breaker.
+ */
+struct I2CParallelRetryPolicy {
+  uint8_t maxAttempts;          // Attempts per transaction, including the first.
+  uint32_t budgetMicros;        // Retry time budget per transaction; 0 for no limit.
+  uint16_t backoffMicros;       // Delay before the first retry.
+  uint8_t breakerThreshold;     // Failed attempts that open the breaker; 0 to disable.
+  uint32_t probeIntervalMicros; // Time between probes while the breaker is open.
+  uint32_t wireTimeoutMicros;   // Wire timeout (shared by all devices on the controller).
+  uint8_t sdaPin;               // SDA and SCL pins for recoverBus(), or INVALID_GPIO_PIN.
+  uint8_t sclPin;               // If set, a timed-out transaction recovers the bus before retrying.
+};
+
+// The policy in effect until setRetryPolicy() is called: one attempt per
+// transaction, no circuit breaker, no bus recovery.
+static constexpr I2CParallelRetryPolicy I2C_PARALLEL_DEFAULT_RETRY_POLICY = {
+  1, 0, 0, 0, 0, I2C_PARALLEL_WIRE_TIMEOUT, INVALID_GPIO_PIN, INVALID_GPIO_PIN
+};
+
+// Operation types for the bus statistics latency histograms.
+static constexpr uint8_t I2C_PARALLEL_OP_WRITE = 0;  // Output writes.
+static constexpr uint8_t I2C_PARALLEL_OP_READ = 1;   // Input reads (and register pointer moves for them).
+static constexpr uint8_t I2C_PARALLEL_OP_CONFIG = 2; // Configuration register access.
+static constexpr uint8_t I2C_PARALLEL_NUM_OPS = 3;
+
+// Latency histogram bucket `b` counts transactions that took [2^b, 2^(b+1))
+// microseconds; bucket 0 also includes 0 us and the last bucket is open-ended.
+static constexpr uint8_t I2C_PARALLEL_STATS_BUCKETS = 12;
+
+/**
+ * Per-device bus statistics. Collected only if I2C_PARALLEL_ENABLE_STATS is
+ * defined; otherwise no counters are kept.
+ *
+ * The define changes the layout of I2CParallel, so it must be a global build
+ * flag (e.g. -DI2C_PARALLEL_ENABLE_STATS in PlatformIO's build_flags) seen by
+ * the library and the sketch alike. A #define in the sketch does not reach
+ * the library's source files, and the mismatch corrupts memory.
+ */
+struct I2CParallelStats {
+  uint32_t transactions; // Completed or attempted bus transactions.
+  uint32_t bytesWritten; // Data bytes written (excluding address bytes).
+  uint32_t bytesRead;    // Data bytes read.
+  uint16_t addrNacks;    // Address not acknowledged (device absent or busy).
+  uint16_t dataNacks;    // Data byte not acknowledged.
+  uint16_t timeouts;     // Bus timeouts reported by Wire.
+  uint16_t otherErrors;  // Short reads, TX buffer overflows and other Wire errors.
+  uint16_t retries;      // Transactions retried under the retry policy.
+  uint16_t rejected;     // Transactions refused while the circuit breaker was open.
+  uint16_t recoveries;   // Bus recoveries performed by recoverBus().
+  uint16_t latency[I2C_PARALLEL_NUM_OPS][I2C_PARALLEL_STATS_BUCKETS];
+};
+
+/**
+ * Chip traits: the bus protocol of each supported device family, shared by
+ * the I2CParallel classes and the I2CParallelT templates.
+ *
+ * Each operation talks to the device through `io`, which performs one bus
+ * transaction per call (`op` is an I2C_PARALLEL_OP_* constant):
+ *
+ *   bool busWrite(const uint8_t* data, uint8_t n, bool sendStop, uint8_t op);
+ *   bool busRead(uint8_t& val, bool sendStop, uint8_t op);
+ *
+ * `regPointer` tracks the last command byte the device ACKed, or
+ * REG_POINTER_UNKNOWN. Error codes and cached register state are left to the
+ * caller.
+ */
+
+/**
+ * Chip traits for the PCF8574 / PCF8574A: a single quasi-bidirectional port
+ * written and read with bare data bytes.
+ */
+struct I2CParallelChip8574 {
+  static constexpr bool HAS_REGISTERS = false;
+  static constexpr bool HAS_RESET = false;
+  // Output valid time after ACK, also the input setup time for a read (4us).
+  static constexpr uint16_t HOLD_NANOS = 4000;
+  static constexpr uint8_t REG_POINTER_UNKNOWN = 0xFF; // No register pointer.
+
+  static constexpr bool isValidAddress(const uint8_t addr) {
+    return (addr >= I2C_PCF8574_MIN_ADDR && addr <= I2C_PCF8574_MAX_ADDR)
+        || (addr >= I2C_PCF8574A_MIN_ADDR && addr <= I2C_PCF8574A_MAX_ADDR);
+  };
+
+  // Latch `val` onto the port.
+  template <typename Io>
+  static bool writeOutput(Io&& io, const uint8_t val) {
+    return io.busWrite(&val, 1, true, I2C_PARALLEL_OP_WRITE);
+  };
+  // Sample the port into `val`.
+  template <typename Io>
+  static bool readInput(Io&& io, uint8_t& val) {
+    return io.busRead(val, true, I2C_PARALLEL_OP_READ);
+  };
+
+  // The same, for callers generic over the chip. The '8574 has a single port,
+  // so every register write lands in the output latch.
+  template <typename Io>
+  static bool writeOutput(Io&& io, const uint8_t val, uint8_t& regPointer) {
+    return writeOutput(io, val);
+  };
+  template <typename Io>
+  static bool readInput(Io&& io, uint8_t& val, uint8_t& regPointer) {
+    return readInput(io, val);
+  };
+  template <typename Io>
+  static bool writeRegister(Io&& io, const uint8_t reg, const uint8_t val, uint8_t& regPointer) {
+    return writeOutput(io, val);
+  };
+};
+
+/**
+ * Chip traits for the PCA9534 / PCA9554 families: INPUT, OUTPUT, POLARITY and
+ * CONFIG registers behind a register pointer. Reads leave the pointer where it
+ * is, so repeated reads of one register need no command byte.
+ */
+struct I2CParallelChip9534 {
+  static constexpr bool HAS_REGISTERS = true;
+  static constexpr bool HAS_RESET = false;
+  // Output valid time after ACK (350ns).
+  static constexpr uint16_t HOLD_NANOS = 350;
+  static constexpr uint8_t REG_POINTER_UNKNOWN = I2C_PCA9534_REG_POINTER_UNKNOWN;
+
+  static constexpr bool isValidAddress(const uint8_t addr) {
+    return (addr >= I2C_PCA9534_MIN_ADDR && addr <= I2C_PCA9534_MAX_ADDR)
+        || (addr >= I2C_PCA9534A_MIN_ADDR && addr <= I2C_PCA9534A_MAX_ADDR)
+        || (addr >= I2C_PCA9538_MIN_ADDR && addr <= I2C_PCA9538_MAX_ADDR);
+  };
+
+  // Statistics category for accesses to register `reg`.
+  static constexpr uint8_t opForRegister(const uint8_t reg) {
+    return reg == I2C_PCA9534_REG_INPUT ? I2C_PARALLEL_OP_READ
+        : reg == I2C_PCA9534_REG_OUTPUT ? I2C_PARALLEL_OP_WRITE
+                                        : I2C_PARALLEL_OP_CONFIG;
+  };
+
+  // Write `val` to register `reg`. With `sendStop` false the bus is held for
+  // another transfer after a repeated START.
+  template <typename Io>
+  static bool writeRegister(Io&& io, const uint8_t reg, const uint8_t val, uint8_t& regPointer,
+      const bool sendStop = true) {
+    const uint8_t data[2] = { reg, val };
+    const bool ok = io.busWrite(data, sizeof(data), sendStop, opForRegister(reg));
+    regPointer = ok ? reg : REG_POINTER_UNKNOWN;
+    return ok;
+  };
+
+  // Point the register pointer at `reg`, ending with a repeated START so a
+  // read can follow. No I/O if the pointer is already there.
+  template <typename Io>
+  static bool selectRegister(Io&& io, const uint8_t reg, uint8_t& regPointer) {
+    if (regPointer == reg) {
+      return true;
+    }
+    const bool ok = io.busWrite(&reg, 1, false, opForRegister(reg));
+    regPointer = ok ? reg : REG_POINTER_UNKNOWN;
+    return ok;
+  };
+
+  // Read register `reg` into `val`.
+  template <typename Io>
+  static bool readRegister(Io&& io, const uint8_t reg, uint8_t& val, uint8_t& regPointer,
+      const bool sendStop = true) {
+    if (!selectRegister(io, reg, regPointer)) {
+      return false;
+    }
+    if (!io.busRead(val, sendStop, opForRegister(reg))) {
+      regPointer = REG_POINTER_UNKNOWN;
+      return false;
+    }
+    return true;
+  };
+
+  template <typename Io>
+  static bool writeOutput(Io&& io, const uint8_t val, uint8_t& regPointer) {
+    return writeRegister(io, I2C_PCA9534_REG_OUTPUT, val, regPointer);
+  };
+  template <typename Io>
+  static bool readInput(Io&& io, uint8_t& val, uint8_t& regPointer) {
+    return readRegister(io, I2C_PCA9534_REG_INPUT, val, regPointer);
+  };
+
+  // TI PCA9534, PCA9538 interrupt bug: INT pin does not work if last-accessed register is
+  // REG_INPUT. Do a write to REG_OUTPUT so the device's internal pointer is no longer on
+  // REG_INPUT. See e.g. https://www.ti.com/lit/ds/scps126g/scps126g.pdf section 7.2.4.1
+  // "Interrupt Errata".
+  template <typename Io>
+  static bool leaveInputRegister(Io&& io, uint8_t& regPointer) {
+    if (regPointer != I2C_PCA9534_REG_INPUT) {
+      return true;
+    }
+    const bool ok = io.busWrite(&I2C_PCA9534_REG_OUTPUT, 1, true, I2C_PARALLEL_OP_READ);
+    regPointer = ok ? I2C_PCA9534_REG_OUTPUT : REG_POINTER_UNKNOWN;
+    return ok;
+  };
+};
+
+/** Chip traits for the PCA9538 / TCA6408A: a '9534 with a RESET_L pin. */
+struct I2CParallelChip9538 : public I2CParallelChip9534 {
+  static constexpr bool HAS_RESET = true;
+};
+
 /**
  * Base class for all I2C parallel bus expander devices.
  *
@@ -80,10 +322,21 @@ static constexpr uint8_t I2C_PARALLEL_ERR_INVALID_PIN =
  */
 class I2CParallel {
 public:
-  I2CParallel()
-      : _i2cAddr(UNINITIALIZED_I2C_ADDR), _error(I2C_PARALLEL_ERR_OK),
-        _outputState(I2C_PARALLEL_STARTUP_INPUT_STATE),
-        _inputState(I2C_PARALLEL_STARTUP_INPUT_STATE){};
+  // `wire` is the I2C controller the device is attached to; `holdNanos` is the
+  // device's output valid / input hold time after a write is ACKed.
+  explicit I2CParallel(TwoWire& wire = Wire, const uint16_t holdNanos = 0)
+      : _wire(&wire), _outputState(I2C_PARALLEL_STARTUP_INPUT_STATE),
+        _inputState(I2C_PARALLEL_STARTUP_INPUT_STATE),
+        _i2cAddr(UNINITIALIZED_I2C_ADDR), _error(I2C_PARALLEL_ERR_OK),
+        _intPin(INVALID_GPIO_PIN), _shadowValid(0), _busSpeed(I2C_PARALLEL_MAX_BUS_SPEED),
+        _updateDepth(0), _updateBaseState(I2C_PARALLEL_STARTUP_INPUT_STATE),
+        _retryPolicy(&I2C_PARALLEL_DEFAULT_RETRY_POLICY), _breakerOpenedMicros(0),
+        _failedAttempts(0), _breakerOpen(false), _holdNanos(holdNanos), _settleNanos(0),
+        _settleFromMicros(0) {
+#ifdef I2C_PARALLEL_ENABLE_STATS
+    resetStats();
+#endif /* I2C_PARALLEL_ENABLE_STATS */
+  };
   ~I2CParallel(){};
 
   // Configure the 8-bit parallel bus with its expected 7-bit I2C address.
@@ -98,15 +351,26 @@ public:
   // pin). Add a pull-up between this pin and Vcc.
   void initInterrupt(const uint8_t digitalPinNum, void (*isr)());
 
+  // Return true if initInterrupt() has attached an ISR to this device's INT_L.
+  bool hasInterrupt() const { return _intPin != INVALID_GPIO_PIN; };
+
   // Set the value to emit on the 8-bit bus. This value is latched and held
   // until overwritten. Implementations may mix this state with input state
   // based on quasi-bidirectional I/O, or may mask part of this output to
   // allow other pins to be driven by external logic.
-  // Returns the number of bytes written (1 on success, 0 on failure).
+  // Returns the number of bytes written (1 on success, 0 on failure). If the
+  // device is known to already hold `val`, no I/O is performed and 1 is returned.
   virtual size_t setByte(const uint8_t val) = 0;
   // Synonym for setByte().
   size_t write(const uint8_t val) { return setByte(val); };
 
+  // Emit a sequence of `n` values on the 8-bit bus, streamed back-to-back in as
+  // few I2C transactions as the Wire TX buffer allows. Each value is sent
+  // `repeat` times in a row, holding it on the pins for that many bus byte-times
+  // (9 SCL periods each) before the next value is latched. Returns the number of
+  // values from `buf` that were written. The last value becomes the output state.
+  virtual size_t setBytes(const uint8_t* buf, const size_t n, const uint8_t repeat = 1) = 0;
+
   // Read back the current contents of the 8-bit bus.
   // This returns the value received and sets nBytesRead to 1 or 0 depending on
   // whether or not it has successfully performed the I/O read. If bytesRead is
@@ -119,6 +383,23 @@ public:
   };
   uint8_t read() { return getByte(); }; // synonym for getByte().
 
+  // Sample the input pins `n` times back-to-back, reading continuously from the
+  // device in as few I2C transactions as the Wire RX buffer allows. If
+  // `timestamps` is non-null, it is filled with the estimated micros() time at
+  // which each sample was latched, derived from the configured bus speed.
+  // Returns the number of samples captured. The last sample becomes the last
+  // known input state.
+  virtual size_t captureBytes(uint8_t* buf, const size_t n, uint32_t* timestamps = nullptr) = 0;
+
+  // Scan a switch matrix wired to this device. For each row i < numRows, pull
+  // the pins in rowMasks[i] low, release the other row pins, and read the
+  // inputs into sense[i]. All rows are scanned in a single I2C transaction
+  // (repeated STARTs between the steps), which ends by releasing every row
+  // pin again. Column pins must already be inputs. Returns the number of rows
+  // read, or 0 if the rows could not be released; the inputs of the last row
+  // become the last known input state.
+  virtual uint8_t scanRows(const uint8_t* rowMasks, const uint8_t numRows, uint8_t* sense) = 0;
+
   // Read back the last known contents of the bus without actually reading over
   // i2c.
   uint8_t getLastInputState() const { return _inputState; };
@@ -133,12 +414,41 @@ public:
   // bits with setByte() will drive those lines low and disable input mode.
   virtual void enableInputs(const uint8_t mask) = 0;
 
+  // Return true if enableInputs() works by setting bits of the output state
+  // (quasi-bidirectional I/O, as on the '8574), rather than a separate
+  // direction register.
+  virtual bool inputsUseOutputLatch() const = 0;
+
+  // Forget what the driver knows about the device's registers, so the next
+  // write to each register goes out over the bus even if the value is the same.
+  // Call this if the device may have been reset or disturbed externally.
+  void invalidateCache() { _shadowValid = 0; };
+
+  // Use `policy` for this device's bus transactions. The policy is not copied
+  // and must stay alive while in use; several devices may share one.
+  void setRetryPolicy(const I2CParallelRetryPolicy& policy);
+  const I2CParallelRetryPolicy& getRetryPolicy() const { return *_retryPolicy; };
+
+  // Return true while the circuit breaker is refusing transactions.
+  bool isCircuitOpen() const { return _breakerOpen; };
+
+  // Free a bus whose SDA line is held low by a device that lost sync mid-byte
+  // (the retry policy's sdaPin and sclPin must be set): clock SCL up to 9
+  // times until SDA is released, then send a STOP and restart the Wire
+  // controller. Returns true if SDA is high afterward.
+  bool recoverBus();
+
+  // Bring the device and the driver's register cache back into agreement.
+  // Devices with readable registers are read back; write-only state is
+  // rewritten from the intended values. Returns true on success.
+  virtual bool resync() = 0;
+
   // Apply a bitwise OR operation to the current bus state.
-  size_t setOr(const uint8_t val) { return setByte(_outputState | val); };
+  size_t setOr(const uint8_t val) { return updateOutput(_outputState | val); };
   // Apply a bitwise AND operation to the current bus state.
-  size_t setAnd(const uint8_t val) { return setByte(_outputState & val); };
+  size_t setAnd(const uint8_t val) { return updateOutput(_outputState & val); };
   // Apply a bitwise XOR operation to the current bus state.
-  size_t setXor(const uint8_t val) { return setByte(_outputState ^ val); };
+  size_t setXor(const uint8_t val) { return updateOutput(_outputState ^ val); };
 
   /** Set the specified bit (0--7) high. */
   size_t setBit(const uint8_t bitPos) {
@@ -177,17 +487,38 @@ public:
   size_t increment() {
     if (_outputState == I2C_PARALLEL_MAX_VAL) {
       _error = I2C_PARALLEL_ERR_CARRY;
-      return setByte(0);
+      return updateOutput(0);
     }
 
-    return setByte(_outputState + 1);
+    return updateOutput(_outputState + 1);
   };
 
+  // Begin a batch of bit-level updates. Until the matching commit(), setOr(),
+  // setAnd(), setXor(), setBit(), clrBit(), toggleBit() and increment() only
+  // update the local output state; the pins do not change. Batches may nest.
+  // (setByte() and setBytes() still write immediately.)
+  void beginUpdate();
+
+  // End a batch begun with beginUpdate(). When the outermost batch ends, the
+  // net output state is written with a single setByte(), or not at all if it
+  // matches the state the batch started from. Returns the number of bytes
+  // written (1 on success or if no write was needed, 0 on failure).
+  size_t commit();
+
+  // Return true if a batch begun with beginUpdate() is in progress.
+  bool isUpdating() const { return _updateDepth > 0; };
+
   // Delay until the transmitted data is ready on the parallel bus,
   // or delay until parallel bus inputs can be queried. This is not called
   // directly by the setByte() implementation; there may be a delay between the
   // setByte() function return and the data being available on the bus I/O pins.
-  virtual void waitForValid() = 0;
+  // Only the part of the device's hold time that has not already passed since
+  // the last write (including its STOP condition) is waited out.
+  void waitForValid();
+
+  // Return true if the device's hold time since the last write has passed,
+  // i.e. waitForValid() would return immediately.
+  bool isValid() const { return _settleNanos == 0 || nanosSinceWrite() >= _settleNanos; };
 
   /** Clear the error code state. */
   void clearError() { _error = I2C_PARALLEL_ERR_OK; };
@@ -201,6 +532,13 @@ public:
   /** Check if the last operation had an error. */
   bool hasError() const { return _error != I2C_PARALLEL_ERR_OK; };
 
+#ifdef I2C_PARALLEL_ENABLE_STATS
+  /** Return the bus statistics collected for this device. */
+  const I2CParallelStats& getStats() const { return _stats; };
+  /** Zero all bus statistics. */
+  void resetStats();
+#endif /* I2C_PARALLEL_ENABLE_STATS */
+
   /** Return the I2C address of the device. */
   uint8_t getAddress() const {
     if (_i2cAddr == UNINITIALIZED_I2C_ADDR) {
@@ -209,7 +547,71 @@ public:
     return _i2cAddr;
   };
 
+  /** Return the bus clock rate given to init(). */
+  uint32_t getBusSpeed() const { return _busSpeed; };
+
 protected:
+  // Bits of _shadowValid: set when the matching register on the device is
+  // known to hold the value cached by the driver.
+  static constexpr uint8_t SHADOW_OUTPUT = 0x01;
+  static constexpr uint8_t SHADOW_CONFIG = 0x02;
+  static constexpr uint8_t SHADOW_POLARITY = 0x04;
+  static constexpr uint8_t SHADOW_ALL = SHADOW_OUTPUT | SHADOW_CONFIG | SHADOW_POLARITY;
+
+  bool isShadowValid(const uint8_t reg) const { return (_shadowValid & reg) != 0; };
+
+  // Apply a new output state from a bit-level operation: write it now, or
+  // defer it to commit() if a batch is in progress.
+  size_t updateOutput(const uint8_t val) {
+    if (_updateDepth > 0) {
+      _outputState = val;
+      return 1;
+    }
+    return setByte(val);
+  };
+
+  // Wrappers around Wire.endTransmission() and Wire.requestFrom() for this
+  // device that maintain the bus statistics. `op` is an I2C_PARALLEL_OP_*
+  // constant, and `nBytes` is the number of data bytes buffered for the write.
+  // These make a single attempt, subject to the circuit breaker.
+  uint8_t endTransmission(const uint8_t op, const size_t nBytes, const bool sendStop);
+  // requestFrom() retries per the retry policy.
+  uint8_t requestFrom(const uint8_t op, const uint8_t quantity, const bool sendStop = true);
+
+  // Write `data[0..n)` to the device as one transaction, retrying per the retry
+  // policy. Returns the Wire endTransmission() status of the last attempt.
+  uint8_t transmit(const uint8_t op, const uint8_t* data, const uint8_t n, const bool sendStop);
+
+  // Set the Wire timeout from the retry policy. Called by init().
+  void applyWireTimeout();
+
+  // Read `n` bytes from the device as a series of bare requestFrom() reads,
+  // timestamping each per captureBytes(). Returns the number of bytes read.
+  size_t readBurst(uint8_t* buf, const size_t n, uint32_t* timestamps);
+
+  // The `io` transport of the I2CParallelChip* protocol code for this device:
+  // transmit() and requestFrom(), so transactions are retried and counted.
+  class DeviceIo {
+  public:
+    explicit DeviceIo(I2CParallel& dev) : _dev(dev){};
+    bool busWrite(const uint8_t* data, const uint8_t n, const bool sendStop, const uint8_t op) {
+      return _dev.transmit(op, data, n, sendStop) == 0;
+    };
+    bool busRead(uint8_t& val, const bool sendStop, const uint8_t op) {
+      if (_dev.requestFrom(op, 1, sendStop) != 1) {
+        return false;
+      }
+      val = _dev._wire->read();
+      return true;
+    };
+
+  private:
+    I2CParallel& _dev;
+  };
+  DeviceIo io() { return DeviceIo(*this); };
+
+  TwoWire* _wire; // I2C controller for this device.
+
   // State of the 8 output data lines.
   uint8_t _outputState;
 
@@ -218,6 +620,62 @@ protected:
 
   uint8_t _i2cAddr;       // Address of chip on the I2C bus.
   mutable uint8_t _error; // Error code from last operation.
+  uint8_t _intPin;        // MCU pin receiving INT_L, or INVALID_GPIO_PIN.
+  uint8_t _shadowValid;   // SHADOW_* bits for registers known to match the device.
+  uint32_t _busSpeed;     // I2C clock rate set by init().
+
+  uint8_t _updateDepth;     // Nesting depth of beginUpdate() calls.
+  uint8_t _updateBaseState; // _outputState when the outermost batch began.
+
+  const I2CParallelRetryPolicy* _retryPolicy;
+  uint32_t _breakerOpenedMicros; // When the breaker opened or last let a probe through.
+  uint8_t _failedAttempts;       // Consecutive failed bus attempts.
+  bool _breakerOpen;
+
+  const uint16_t _holdNanos;  // Output valid / input hold time after an ACK.
+  uint16_t _settleNanos;      // Hold time left after the last write's STOP; 0 if none.
+  uint32_t _settleFromMicros; // micros() when that write completed.
+
+#ifdef I2C_PARALLEL_ENABLE_STATS
+  I2CParallelStats _stats;
+#endif /* I2C_PARALLEL_ENABLE_STATS */
+
+private:
+  // Start the hold time for a write that has just been ACKed.
+  void startSettle(const bool sendStop);
+  // Lower bound on the nanoseconds since the last write completed.
+  uint32_t nanosSinceWrite() const;
+
+  uint8_t requestFromOnce(const uint8_t op, const uint8_t quantity, const bool sendStop);
+  // Circuit breaker bookkeeping around each bus attempt.
+  bool allowAttempt();
+  void recordAttempt(const bool ok);
+  // Decide whether to retry after failed attempt number `attempt` of a
+  // transaction that began at `start`, and wait out the backoff if so.
+  bool retryAfter(const uint8_t attempt, const uint32_t start, uint16_t& backoff,
+      const bool timedOut);
+};
+
+/**
+ * Scope guard for a batch of bit-level updates to an I2CParallel device.
+ * Calls beginUpdate() on construction and commit() when it goes out of scope:
+ *
+ *   {
+ *     I2CParallelUpdate update(parallel);
+ *     parallel.setBit(1);
+ *     parallel.clrBit(4);
+ *   } // Both pins change together in one write here.
+ */
+class I2CParallelUpdate {
+public:
+  explicit I2CParallelUpdate(I2CParallel& dev) : _dev(dev) { _dev.beginUpdate(); };
+  ~I2CParallelUpdate() { _dev.commit(); };
+
+  I2CParallelUpdate(const I2CParallelUpdate&) = delete;
+  I2CParallelUpdate& operator=(const I2CParallelUpdate&) = delete;
+
+private:
+  I2CParallel& _dev;
 };
 
 /**
@@ -226,7 +684,8 @@ protected:
  */
 class I2CParallel8574 : public I2CParallel {
 public:
-  I2CParallel8574() : I2CParallel(){};
+  explicit I2CParallel8574(TwoWire& wire = Wire)
+      : I2CParallel(wire, I2CParallelChip8574::HOLD_NANOS){};
   ~I2CParallel8574(){};
 
   virtual void
@@ -235,11 +694,26 @@ public:
 
   virtual size_t setByte(const uint8_t val) override final;
 
+  // Every data byte the '8574 ACKs is latched onto the port.
+  virtual size_t setBytes(
+      const uint8_t* buf, const size_t n, const uint8_t repeat = 1) override final;
+
   virtual uint8_t getByte(uint8_t &nBytesRead) override final;
 
+  // Every byte read from the '8574 is a fresh sample of the port.
+  virtual size_t captureBytes(
+      uint8_t* buf, const size_t n, uint32_t* timestamps = nullptr) override final;
+
+  // Each row is a port write followed by a read of the port; released rows
+  // and the columns are held high by the quasi-bidirectional pull-ups.
+  virtual uint8_t scanRows(
+      const uint8_t* rowMasks, const uint8_t numRows, uint8_t* sense) override final;
+
   virtual void enableInputs(const uint8_t mask) override final;
+  virtual bool inputsUseOutputLatch() const override final { return true; };
 
-  virtual void waitForValid() override final;
+  // The '8574 output latch cannot be read back; this rewrites _outputState.
+  virtual bool resync() override final;
 };
 
 /**
@@ -248,7 +722,11 @@ public:
  */
 class I2CParallel9534 : public I2CParallel {
 public:
-  I2CParallel9534() : I2CParallel(), _polarityState(0){};
+  explicit I2CParallel9534(TwoWire& wire = Wire)
+      : I2CParallel(wire, I2CParallelChip9534::HOLD_NANOS), _polarityState(0),
+        _configState(I2C_PARALLEL_STARTUP_INPUT_STATE),
+        _regPointer(REG_POINTER_UNKNOWN), _intPinMode(I2C_PARALLEL_INT_AUTO),
+        _brownoutCount(0){};
   ~I2CParallel9534(){};
 
   virtual void
@@ -257,18 +735,99 @@ public:
 
   virtual size_t setByte(const uint8_t val) override final;
 
+  // Each data byte after the command byte overwrites the OUTPUT register.
+  virtual size_t setBytes(
+      const uint8_t* buf, const size_t n, const uint8_t repeat = 1) override final;
+
   virtual uint8_t getByte(uint8_t &nBytesRead) override final;
 
-  virtual void enableInputs(const uint8_t mask) override final;
+  // Repeated reads of the INPUT register each return a fresh sample.
+  virtual size_t captureBytes(
+      uint8_t* buf, const size_t n, uint32_t* timestamps = nullptr) override final;
 
-  // 350ns hold.
-  virtual void waitForValid() override final;
+  // Rows are switched through the CONFIG register: the row pins' OUTPUT bits
+  // are held at 0 and only the active row is configured as an output, so the
+  // released rows float rather than being driven high. Row and column pins
+  // need external pull-ups.
+  virtual uint8_t scanRows(
+      const uint8_t* rowMasks, const uint8_t numRows, uint8_t* sense) override final;
+
+  virtual void enableInputs(const uint8_t mask) override final;
+  virtual bool inputsUseOutputLatch() const override final { return false; };
 
   // Set the polarity of the input register.
   void setInputPolarity(const uint8_t polarity);
 
+  // Read back the OUTPUT, CONFIG and POLARITY registers into the driver's cache.
+  virtual bool resync() override;
+
+  // Read back the last known contents of the configuration register (1 bits
+  // are inputs) and the polarity register without reading from the device.
+  uint8_t getLastConfigState() const { return _configState; };
+  uint8_t getLastPolarityState() const { return _polarityState; };
+
+  // Write the cached OUTPUT, POLARITY and CONFIG state back to a device that
+  // has returned to its power-on defaults (after RESET_L or a brownout), as one
+  // bus transaction. OUTPUT is written before CONFIG, so pins that become
+  // outputs drive their intended level at once. Registers whose cached value
+  // is the power-on default are skipped.
+  virtual bool restore();
+
+  // Check for a device that has lost its register state, e.g. to a brownout,
+  // by reading back one register the driver has moved off its power-on
+  // default. On a mismatch, restore() the cached state and return true. No bus
+  // I/O if every cached register is still at its default.
+  bool checkBrownout();
+  // Number of times checkBrownout() has found and restored a reset device.
+  uint16_t getBrownoutCount() const { return _brownoutCount; };
+
+  // Declare how the device's INT_L pin is used; one of the I2C_PARALLEL_INT_*
+  // constants. With I2C_PARALLEL_INT_NONE, the first getByte() aims the
+  // register pointer at the input register and later reads are a single bus
+  // read until some other register is written.
+  void setIntPinMode(const uint8_t mode) { _intPinMode = mode; };
+  uint8_t getIntPinMode() const { return _intPinMode; };
+
 protected:
+  // _regPointer value when the device's register pointer is not known.
+  static constexpr uint8_t REG_POINTER_UNKNOWN = I2CParallelChip9534::REG_POINTER_UNKNOWN;
+
+  // Return true if getByte() must move the register pointer off the input
+  // register to keep INT_L working.
+  virtual bool needsIntErrataWrite() const {
+    return _intPinMode == I2C_PARALLEL_INT_CONNECTED
+        || (_intPinMode == I2C_PARALLEL_INT_AUTO && hasInterrupt());
+  };
+
+  // A register write queued by restore().
+  struct RegisterWrite {
+    uint8_t reg;
+    uint8_t val;
+  };
+  static constexpr uint8_t MAX_RESTORE_WRITES = 12;
+
+  // Append the writes restore() needs for device-specific registers after
+  // `writes[0..n)`, returning the new count. They are sent after OUTPUT and
+  // POLARITY, and before CONFIG.
+  virtual uint8_t addRestoreWrites(RegisterWrite* writes, uint8_t n) { return n; };
+
+  // Write `val` to the device register `reg`. Returns true on success. With
+  // `sendStop` false the bus is held for another write after a repeated START.
+  bool writeRegister(const uint8_t reg, const uint8_t val, const bool sendStop = true);
+  // Point the device's register pointer at `reg`, ending with a repeated START
+  // so a read can follow. No I/O if the pointer is already there.
+  bool selectRegister(const uint8_t reg);
+  // Read the device register `reg` into `val`. Returns true on success. With
+  // `sendStop` false the bus is held after the read.
+  bool readRegister(const uint8_t reg, uint8_t& val, const bool sendStop = true);
+  // Move the register pointer off REG_INPUT if the INT errata requires it.
+  void applyIntErrata();
+
   uint8_t _polarityState;
+  uint8_t _configState;
+  uint8_t _regPointer; // Last command byte ACKed by the device.
+  uint8_t _intPinMode;
+  uint16_t _brownoutCount;
 };
 
 typedef class I2CParallel9534 I2CParallel9554;
@@ -279,21 +838,123 @@ typedef class I2CParallel9534 I2CParallel9554;
  */
 class I2CParallel9538 : public I2CParallel9534 {
 public:
-  I2CParallel9538(const uint8_t resetPin)
-      : I2CParallel9534(), _resetPin(resetPin){};
+  explicit I2CParallel9538(const uint8_t resetPin, TwoWire& wire = Wire)
+      : I2CParallel9534(wire), _resetPin(resetPin), _restoreOnReset(false){};
   ~I2CParallel9538(){};
 
   virtual void
   init(const uint8_t i2cAddr,
-       const uint32_t busSpeed = I2C_PARALLEL_MAX_BUS_SPEED) override final;
+       const uint32_t busSpeed = I2C_PARALLEL_MAX_BUS_SPEED) override;
 
-  // Asserts the RESET_L pin low to reset the device.
-  void reset();
+  // Asserts the RESET_L pin low to reset the device. If restore-on-reset is
+  // enabled, the cached register state is then written back with restore();
+  // otherwise the cache is set to the power-on defaults.
+  virtual void reset();
 
-private:
+  // Keep the driver's register state across reset() and replay it to the
+  // device immediately after RESET_L is released.
+  void setRestoreOnReset(const bool restoreOnReset) { _restoreOnReset = restoreOnReset; };
+  bool getRestoreOnReset() const { return _restoreOnReset; };
+
+protected:
   const uint8_t _resetPin;
+  bool _restoreOnReset;
 };
 
 typedef class I2CParallel9538 I2CParallel6408A;
 
+/**
+ * Implementation of I2CParallel for the TCAL6408 "agile I/O" expander: a
+ * '6408A with input latches, per-pin interrupt masks and an interrupt status
+ * register, programmable output drive strength, push-pull or open-drain
+ * outputs, and integrated pull-up / pull-down resistors.
+ * See datasheet: https://www.ti.com/lit/ds/symlink/tcal6408.pdf
+ */
+class I2CParallelTCAL6408 : public I2CParallel9538 {
+public:
+  explicit I2CParallelTCAL6408(const uint8_t resetPin, TwoWire& wire = Wire)
+      : I2CParallel9538(resetPin, wire), _driveState(DRIVE_POWER_ON),
+        _inputLatchState(0), _pullEnableState(0), _pullSelectState(I2C_PARALLEL_MAX_VAL),
+        _intMaskState(I2C_PARALLEL_MAX_VAL), _outputConfigState(0){};
+  ~I2CParallelTCAL6408(){};
+
+  // The TCAL6408 only answers at 0x20 or 0x21 (ADDR pin low or high).
+  virtual void
+  init(const uint8_t i2cAddr,
+       const uint32_t busSpeed = I2C_PARALLEL_MAX_BUS_SPEED) override final;
+
+  // Latch the input pins in `mask`: a change on a latched pin holds its new
+  // value in the input register, and holds INT_L asserted, until the input
+  // register is read, even if the pin changes back first. Power-on: 0x00.
+  void setInputLatch(const uint8_t mask);
+
+  // Connect a 100 kOhm resistor to the pins in `enableMask`: a pull-up for
+  // the pins also in `pullUpMask`, otherwise a pull-down. Power-on: disabled.
+  void setPullResistors(const uint8_t enableMask, const uint8_t pullUpMask);
+
+  // Set the output drive strength of `pin` to an I2C_PARALLEL_DRIVE_* value.
+  void setDriveStrength(const uint8_t pin, const uint8_t strength);
+  // Set the drive strength of every pin: two bits per pin, pin 0 in bits 1:0.
+  void setDriveStrengths(const uint16_t strengths);
+
+  // Set the interrupt mask register: 1 bits keep a pin's changes from
+  // asserting INT_L. Power-on: 0xFF, so INT_L is unused until this is called.
+  void setInterruptMask(const uint8_t mask);
+
+  // Make every output open-drain (true) or push-pull (false; power-on).
+  void setOpenDrain(const bool openDrain);
+
+  // Read the interrupt status register: 1 bits are unmasked pins that have
+  // changed since the input register was last read. Does not clear INT_L.
+  uint8_t getInterruptStatus();
+
+  // Read the interrupt status register and then the input register in one
+  // bus transaction. Returns the status bits (the pins that caused INT_L);
+  // the input values are available from getLastInputState(). Reading the input
+  // register clears INT_L and releases latched inputs.
+  uint8_t getChangedPins();
+
+  // Asserts the RESET_L pin low to reset the device. See I2CParallel9538::reset().
+  virtual void reset() override final;
+
+  // Read back every register into the driver's cache.
+  virtual bool resync() override final;
+
+  // Also restores the agile I/O registers.
+  virtual bool restore() override final;
+
+  uint8_t getLastInputLatchState() const { return _inputLatchState; };
+  uint8_t getLastPullEnableState() const { return _pullEnableState; };
+  uint8_t getLastPullSelectState() const { return _pullSelectState; };
+  uint16_t getLastDriveState() const { return _driveState; };
+  uint8_t getLastInterruptMaskState() const { return _intMaskState; };
+  bool isOpenDrain() const { return _outputConfigState != 0; };
+
+protected:
+  // The TCAL6408 does not have the '9534 INT_L errata.
+  virtual bool needsIntErrataWrite() const override { return false; };
+
+  virtual uint8_t addRestoreWrites(RegisterWrite* writes, uint8_t n) override final;
+
+private:
+  static constexpr uint16_t DRIVE_POWER_ON = 0xFFFF;
+
+  // Bits of _shadowValid for the agile I/O registers.
+  static constexpr uint8_t SHADOW_DRIVE = 0x08;
+  static constexpr uint8_t SHADOW_INPUT_LATCH = 0x10;
+  static constexpr uint8_t SHADOW_PULL = 0x20;
+  static constexpr uint8_t SHADOW_INT_MASK = 0x40;
+  static constexpr uint8_t SHADOW_OUTPUT_CONFIG = 0x80;
+
+  // Write `val` to `reg` unless the `shadow` bit says it already holds it.
+  void writeShadowed(const uint8_t reg, const uint8_t shadow, uint8_t& cached, const uint8_t val);
+
+  uint16_t _driveState;
+  uint8_t _inputLatchState;
+  uint8_t _pullEnableState;
+  uint8_t _pullSelectState;
+  uint8_t _intMaskState;
+  uint8_t _outputConfigState;
+};
+
 #endif /* I2C_PARALLEL_H */
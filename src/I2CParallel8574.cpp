@@ -13,11 +13,6 @@
 
 #include "I2CParallel2.h"
 
-// The time delay from I2C acknowledge until the output is valid.
-// (Also the hold time needed for driven inputs before the data can be reported
-// back.)
-static constexpr unsigned int I2C_PARALLEL_HOLD_TIME_MICROS = 4;
-
 // Always end our i2c transmissions with the STOP signal.
 static constexpr uint8_t SEND_STOP = 1;
 
@@ -26,16 +21,11 @@ static constexpr uint8_t SEND_STOP = 1;
 // for actual communication.
 static constexpr uint8_t I2C_PARALLEL_ADDR_MASK = 0x7F;
 
-// Timeout duration for I2C communications in microseconds; use 25 ms.
-static constexpr unsigned int I2C_PARALLEL_WIRE_TIMEOUT = 25000;
-
 void I2CParallel8574::init(const uint8_t i2cAddr, const uint32_t busSpeed) {
   _error = I2C_PARALLEL_ERR_OK; // Clear any previous errors.
   _i2cAddr = i2cAddr & I2C_PARALLEL_ADDR_MASK;
 
-  if (_i2cAddr < I2C_PCF8574_MIN_ADDR ||
-      (_i2cAddr > I2C_PCF8574_MAX_ADDR && _i2cAddr < I2C_PCF8574A_MIN_ADDR) ||
-      _i2cAddr > I2C_PCF8574A_MAX_ADDR) {
+  if (!I2CParallelChip8574::isValidAddress(_i2cAddr)) {
     // Invalid I2C address range.
     _error = I2C_PARALLEL_ERR_ADDR;
   }
@@ -45,13 +35,12 @@ void I2CParallel8574::init(const uint8_t i2cAddr, const uint32_t busSpeed) {
     _error = I2C_PARALLEL_ERR_BUS_SPEED;
   }
 
-  Wire.setClock(busSpeed);
-#if defined(ARDUINO_ARCH_SAMD) || defined(ARDUINO_TEENSY41)
-  Wire.setTimeout(I2C_PARALLEL_WIRE_TIMEOUT);
-#else
-  // This is the default for the __ARCH_AVR__ Wire library.
-  Wire.setWireTimeout(I2C_PARALLEL_WIRE_TIMEOUT, true);
-#endif
+  // The output latch state is unknown until the first write.
+  invalidateCache();
+
+  _busSpeed = busSpeed;
+  _wire->setClock(busSpeed);
+  applyWireTimeout();
 }
 
 size_t I2CParallel8574::setByte(const uint8_t val) {
@@ -59,13 +48,17 @@ size_t I2CParallel8574::setByte(const uint8_t val) {
   if (_i2cAddr == UNINITIALIZED_I2C_ADDR) {
     // Only transmit if we have initialized the i2c bus.
     _error = I2C_PARALLEL_ERR_UNINITIALIZED;
+  } else if (isShadowValid(SHADOW_OUTPUT) && val == _outputState) {
+    // The output latch already holds this value.
+    return 1;
   } else {
-    Wire.beginTransmission(_i2cAddr);
-    numWritten = Wire.write(val);
-    if (numWritten != 1) {
+    if (!I2CParallelChip8574::writeOutput(io(), val)) {
       _error = I2C_PARALLEL_ERR_BUS_IO;
+      _shadowValid &= ~SHADOW_OUTPUT;
+    } else {
+      numWritten = 1;
+      _shadowValid |= SHADOW_OUTPUT;
     }
-    Wire.endTransmission(SEND_STOP);
   }
   // Update the local "intended output state" regardless of whether the write
   // succeeded.
@@ -73,32 +66,133 @@ size_t I2CParallel8574::setByte(const uint8_t val) {
   return numWritten;
 }
 
+size_t I2CParallel8574::setBytes(const uint8_t* buf, const size_t n, const uint8_t repeat) {
+  if (_i2cAddr == UNINITIALIZED_I2C_ADDR) {
+    _error = I2C_PARALLEL_ERR_UNINITIALIZED;
+    return 0;
+  } else if (n == 0) {
+    return 0;
+  }
+
+  const uint8_t numCopies = (repeat == 0) ? 1 : repeat;
+  size_t numSent = 0;     // Values from buf that have been fully transmitted.
+  size_t numBuffered = 0; // Bytes in the current transaction.
+  bool ok = true;
+
+  _wire->beginTransmission(_i2cAddr);
+  for (size_t i = 0; i < n && ok; i++) {
+    for (uint8_t copy = 0; copy < numCopies; copy++) {
+      if (_wire->write(buf[i]) == 1) {
+        numBuffered++;
+        continue;
+      }
+      // The Wire TX buffer is full. Send it, and continue in a new transaction.
+      if (endTransmission(I2C_PARALLEL_OP_WRITE, numBuffered, SEND_STOP) != 0) {
+        ok = false;
+        break;
+      }
+      numSent = i;
+      _wire->beginTransmission(_i2cAddr);
+      numBuffered = _wire->write(buf[i]);
+      if (numBuffered != 1) {
+        ok = false;
+        break;
+      }
+    }
+  }
+  if (ok && endTransmission(I2C_PARALLEL_OP_WRITE, numBuffered, SEND_STOP) == 0) {
+    numSent = n;
+  }
+
+  _outputState = buf[n - 1];
+  if (numSent == n) {
+    _shadowValid |= SHADOW_OUTPUT;
+  } else {
+    _error = I2C_PARALLEL_ERR_BUS_IO;
+    _shadowValid &= ~SHADOW_OUTPUT;
+  }
+  return numSent;
+}
+
 uint8_t I2CParallel8574::getByte(uint8_t &nBytesRead) {
   nBytesRead = 0;
   if (_i2cAddr == UNINITIALIZED_I2C_ADDR) {
     // Only actually perform I/O if I2C has been initialized.
     _error = I2C_PARALLEL_ERR_UNINITIALIZED;
   } else {
-    // Request 1 byte of data from the "read address" of the device
+    // Read 1 byte of data from the "read address" of the device
     // (@ write_addr + 1)
-    nBytesRead = Wire.requestFrom((uint8_t)_i2cAddr, (uint8_t)1);
-    if (nBytesRead != 1) {
-      // Do not update the _inputState; keep it at the last-known value.
-      // The error flag and nBytesRead <- 0 indicate to the caller that this
-      // value is not trustworthy.
+    if (!I2CParallelChip8574::readInput(io(), _inputState)) {
+      // _inputState keeps the last-known value. The error flag and
+      // nBytesRead <- 0 indicate to the caller that this value is not
+      // trustworthy.
       _error = I2C_PARALLEL_ERR_BUS_IO;
     } else {
-      _inputState = Wire.read();
+      nBytesRead = 1;
     }
   }
   return _inputState;
 }
 
+size_t I2CParallel8574::captureBytes(uint8_t* buf, const size_t n, uint32_t* timestamps) {
+  if (_i2cAddr == UNINITIALIZED_I2C_ADDR) {
+    _error = I2C_PARALLEL_ERR_UNINITIALIZED;
+    return 0;
+  }
+  return readBurst(buf, n, timestamps);
+}
+
+uint8_t I2CParallel8574::scanRows(
+    const uint8_t* rowMasks, const uint8_t numRows, uint8_t* sense) {
+  if (_i2cAddr == UNINITIALIZED_I2C_ADDR) {
+    _error = I2C_PARALLEL_ERR_UNINITIALIZED;
+    return 0;
+  }
+  if (numRows == 0) {
+    return 0; // Nothing to scan; the registers must not be marked as written.
+  }
+
+  uint8_t allRows = 0;
+  for (uint8_t i = 0; i < numRows; i++) {
+    allRows |= rowMasks[i];
+  }
+
+  // Per row: S, write the port, Sr, read the port. The read's address byte
+  // takes longer than the '8574 output valid time, so the inputs have settled.
+  uint8_t numRead = 0;
+  for (uint8_t i = 0; i < numRows; i++) {
+    _outputState = (_outputState | allRows) & ~rowMasks[i];
+    if (transmit(I2C_PARALLEL_OP_WRITE, &_outputState, 1, false) != 0
+        || requestFrom(I2C_PARALLEL_OP_READ, 1, false) != 1) {
+      break;
+    }
+    sense[i] = _inputState = _wire->read();
+    numRead++;
+  }
+
+  // Then Sr and release every row, so none is left driven low between scans.
+  if (numRead == numRows) {
+    _outputState |= allRows;
+    if (transmit(I2C_PARALLEL_OP_WRITE, &_outputState, 1, true) != 0) {
+      numRead = 0;
+    }
+  }
+
+  if (numRead == numRows) {
+    _shadowValid |= SHADOW_OUTPUT;
+  } else {
+    _error = I2C_PARALLEL_ERR_BUS_IO;
+    _shadowValid &= ~SHADOW_OUTPUT;
+  }
+  return numRead;
+}
+
 void I2CParallel8574::enableInputs(const uint8_t mask) {
   // Quasi-bidirectional I/O: set the specified bits high to enable inputs.
   setOr(mask);
 };
 
-void I2CParallel8574::waitForValid() {
-  delayMicroseconds(I2C_PARALLEL_HOLD_TIME_MICROS);
+bool I2CParallel8574::resync() {
+  invalidateCache();
+  return setByte(_outputState) == 1;
 }
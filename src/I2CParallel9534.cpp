@@ -14,21 +14,22 @@
 
 #include "I2CParallel2.h"
 
-// The time delay from I2C acknowledge until the output is valid (350ns).
-// delayMicroseconds(1) is a conservative over-estimate on platforms without delayNanoseconds.
-static constexpr unsigned int I2C_PARALLEL_HOLD_TIME_MICROS = 1;
-
 static constexpr uint8_t POLARITY_INVERTED = 0x01;
 static constexpr uint8_t POLARITY_NORMAL = 0x00;
 
 static constexpr uint8_t CONFIG_DIRECTION_INPUT = 0x01;
 static constexpr uint8_t CONFIG_DIRECTION_OUTPUT = 0x00;
 
+// Power-on register defaults.
+static constexpr uint8_t POWER_ON_OUTPUT = I2C_PCA9534_POWER_ON_OUTPUT;
+static constexpr uint8_t POWER_ON_POLARITY = I2C_PCA9534_POWER_ON_POLARITY;
+static constexpr uint8_t POWER_ON_CONFIG = I2C_PCA9534_POWER_ON_CONFIG;
+
 // Register addresses for the command byte to send to the device.
-static constexpr uint8_t REG_INPUT = 0x00;
-static constexpr uint8_t REG_OUTPUT = 0x01;
-static constexpr uint8_t REG_CONFIG = 0x02;
-static constexpr uint8_t REG_POLARITY = 0x03;
+static constexpr uint8_t REG_INPUT = I2C_PCA9534_REG_INPUT;
+static constexpr uint8_t REG_OUTPUT = I2C_PCA9534_REG_OUTPUT;
+static constexpr uint8_t REG_POLARITY = I2C_PCA9534_REG_POLARITY;
+static constexpr uint8_t REG_CONFIG = I2C_PCA9534_REG_CONFIG;
 
 // Always end our i2c transmissions with the STOP signal.
 static constexpr uint8_t SEND_STOP = 1;
@@ -36,16 +37,11 @@ static constexpr uint8_t SEND_STOP = 1;
 // Use only the 7 less-significant bits of the address.
 static constexpr uint8_t I2C_PARALLEL_ADDR_MASK = 0x7F;
 
-// Timeout duration for I2C communications in microseconds; use 25 ms.
-static constexpr unsigned int I2C_PARALLEL_WIRE_TIMEOUT = 25000;
-
 void I2CParallel9534::init(const uint8_t i2cAddr, const uint32_t busSpeed) {
   _error = I2C_PARALLEL_ERR_OK;
   _i2cAddr = i2cAddr & I2C_PARALLEL_ADDR_MASK;
 
-  if ((_i2cAddr < I2C_PCA9534_MIN_ADDR || _i2cAddr > I2C_PCA9534_MAX_ADDR) &&
-      (_i2cAddr < I2C_PCA9534A_MIN_ADDR || _i2cAddr > I2C_PCA9534A_MAX_ADDR) &&
-      (_i2cAddr < I2C_PCA9538_MIN_ADDR || _i2cAddr > I2C_PCA9538_MAX_ADDR)) {
+  if (!I2CParallelChip9534::isValidAddress(_i2cAddr)) {
     _error = I2C_PARALLEL_ERR_ADDR;
   }
 
@@ -53,33 +49,112 @@ void I2CParallel9534::init(const uint8_t i2cAddr, const uint32_t busSpeed) {
     _error = I2C_PARALLEL_ERR_BUS_SPEED;
   }
 
-  Wire.setClock(busSpeed);
-#if defined(ARDUINO_ARCH_SAMD) || defined(ARDUINO_TEENSY41)
-  Wire.setTimeout(I2C_PARALLEL_WIRE_TIMEOUT);
-#else
-  Wire.setWireTimeout(I2C_PARALLEL_WIRE_TIMEOUT, true);
-#endif
+  // We don't know what the device's register pointer or registers were left at.
+  _regPointer = REG_POINTER_UNKNOWN;
+  invalidateCache();
+
+  _busSpeed = busSpeed;
+  _wire->setClock(busSpeed);
+  applyWireTimeout();
+}
+
+bool I2CParallel9534::writeRegister(const uint8_t reg, const uint8_t val, const bool sendStop) {
+  if (!I2CParallelChip9534::writeRegister(io(), reg, val, _regPointer, sendStop)) {
+    _error = I2C_PARALLEL_ERR_BUS_IO;
+    return false;
+  }
+  return true;
+}
+
+bool I2CParallel9534::selectRegister(const uint8_t reg) {
+  // 9534 read protocol: write register byte -> ACK -> repeated start -> read addr -> read byte
+  if (!I2CParallelChip9534::selectRegister(io(), reg, _regPointer)) {
+    _error = I2C_PARALLEL_ERR_BUS_IO;
+    return false;
+  }
+  return true;
+}
+
+bool I2CParallel9534::readRegister(const uint8_t reg, uint8_t& val, const bool sendStop) {
+  if (!I2CParallelChip9534::readRegister(io(), reg, val, _regPointer, sendStop)) {
+    _error = I2C_PARALLEL_ERR_BUS_IO;
+    return false;
+  }
+  return true;
 }
 
 size_t I2CParallel9534::setByte(const uint8_t val) {
-  size_t numWritten = 0;
   if (_i2cAddr == UNINITIALIZED_I2C_ADDR) {
     _error = I2C_PARALLEL_ERR_UNINITIALIZED;
-  } else {
-    Wire.beginTransmission(_i2cAddr);
-    numWritten = Wire.write(REG_OUTPUT);
-    if (numWritten == 1) {
-      numWritten += Wire.write(val);
-    }
-    if (numWritten != 2) {
-      _error = I2C_PARALLEL_ERR_BUS_IO;
-      numWritten = 0;
-    } else {
-      Wire.endTransmission(SEND_STOP);
-    }
+    _outputState = val;
+    return 0;
+  }
+
+  if (isShadowValid(SHADOW_OUTPUT) && val == _outputState) {
+    return 1; // The output register already holds this value.
   }
+
   _outputState = val;
-  return (numWritten == 2) ? 1 : 0;
+  if (!writeRegister(REG_OUTPUT, val)) {
+    _shadowValid &= ~SHADOW_OUTPUT;
+    return 0;
+  }
+  _shadowValid |= SHADOW_OUTPUT;
+  return 1;
+}
+
+size_t I2CParallel9534::setBytes(const uint8_t* buf, const size_t n, const uint8_t repeat) {
+  if (_i2cAddr == UNINITIALIZED_I2C_ADDR) {
+    _error = I2C_PARALLEL_ERR_UNINITIALIZED;
+    return 0;
+  } else if (n == 0) {
+    return 0;
+  }
+
+  const uint8_t numCopies = (repeat == 0) ? 1 : repeat;
+  size_t numSent = 0; // Values from buf that have been fully transmitted.
+  size_t numBuffered; // Bytes in the current transaction.
+  bool ok = true;
+
+  // The register pointer does not auto-increment; every byte after the command
+  // byte overwrites REG_OUTPUT.
+  _wire->beginTransmission(_i2cAddr);
+  numBuffered = _wire->write(REG_OUTPUT);
+  for (size_t i = 0; i < n && ok; i++) {
+    for (uint8_t copy = 0; copy < numCopies; copy++) {
+      if (_wire->write(buf[i]) == 1) {
+        numBuffered++;
+        continue;
+      }
+      // The Wire TX buffer is full. Send it, and continue in a new transaction.
+      if (endTransmission(I2C_PARALLEL_OP_WRITE, numBuffered, SEND_STOP) != 0) {
+        ok = false;
+        break;
+      }
+      numSent = i;
+      _wire->beginTransmission(_i2cAddr);
+      numBuffered = _wire->write(REG_OUTPUT);
+      if (_wire->write(buf[i]) != 1) {
+        ok = false;
+        break;
+      }
+      numBuffered++;
+    }
+  }
+  if (ok && endTransmission(I2C_PARALLEL_OP_WRITE, numBuffered, SEND_STOP) == 0) {
+    numSent = n;
+  }
+
+  _outputState = buf[n - 1];
+  if (numSent == n) {
+    _regPointer = REG_OUTPUT;
+    _shadowValid |= SHADOW_OUTPUT;
+  } else {
+    _error = I2C_PARALLEL_ERR_BUS_IO;
+    _regPointer = REG_POINTER_UNKNOWN;
+    _shadowValid &= ~SHADOW_OUTPUT;
+  }
+  return numSent;
 }
 
 uint8_t I2CParallel9534::getByte(uint8_t &nBytesRead) {
@@ -89,26 +164,93 @@ uint8_t I2CParallel9534::getByte(uint8_t &nBytesRead) {
     return _inputState;
   }
 
-  // 9534 read protocol: write register byte -> ACK -> repeated start -> read addr -> read byte
-  Wire.beginTransmission(_i2cAddr);
-  Wire.write(REG_INPUT);
-  Wire.endTransmission(false);  // Repeated start, no STOP
+  uint8_t val;
+  if (!readRegister(REG_INPUT, val)) {
+    return _inputState;
+  }
+  _inputState = val;
+  nBytesRead = 1;
 
-  nBytesRead = Wire.requestFrom((uint8_t)_i2cAddr, (uint8_t)1);
-  if (nBytesRead != 1) {
+  applyIntErrata();
+  return _inputState;
+}
+
+void I2CParallel9534::applyIntErrata() {
+  if (needsIntErrataWrite() && !I2CParallelChip9534::leaveInputRegister(io(), _regPointer)) {
     _error = I2C_PARALLEL_ERR_BUS_IO;
-    return _inputState;
   }
-  _inputState = Wire.read();
+}
 
-  // TI PCA9534, PCA9538 interrupt bug: INT pin does not work if last-accessed register is REG_INPUT.
-  // Do a write to REG_OUTPUT so the device's internal pointer is no longer on REG_INPUT.
-  // See e.g. https://www.ti.com/lit/ds/scps126g/scps126g.pdf section 7.2.4.1 "Interrupt Errata".
-  Wire.beginTransmission(_i2cAddr);
-  Wire.write(REG_OUTPUT);
-  Wire.endTransmission(SEND_STOP);
+size_t I2CParallel9534::captureBytes(uint8_t* buf, const size_t n, uint32_t* timestamps) {
+  if (_i2cAddr == UNINITIALIZED_I2C_ADDR) {
+    _error = I2C_PARALLEL_ERR_UNINITIALIZED;
+    return 0;
+  } else if (n == 0) {
+    return 0;
+  }
 
-  return _inputState;
+  // Aim the register pointer at REG_INPUT once; every byte read after that is a new sample.
+  if (!selectRegister(REG_INPUT)) {
+    return 0;
+  }
+
+  const size_t numRead = readBurst(buf, n, timestamps);
+  if (numRead != n) {
+    _regPointer = REG_POINTER_UNKNOWN;
+  }
+  applyIntErrata();
+  return numRead;
+}
+
+uint8_t I2CParallel9534::scanRows(
+    const uint8_t* rowMasks, const uint8_t numRows, uint8_t* sense) {
+  if (_i2cAddr == UNINITIALIZED_I2C_ADDR) {
+    _error = I2C_PARALLEL_ERR_UNINITIALIZED;
+    return 0;
+  }
+  if (numRows == 0) {
+    return 0; // Nothing to scan; the registers must not be marked as written.
+  }
+
+  uint8_t allRows = 0;
+  for (uint8_t i = 0; i < numRows; i++) {
+    allRows |= rowMasks[i];
+  }
+  // An active row drives its OUTPUT bit, which must be 0.
+  if ((_outputState & allRows) != 0 || !isShadowValid(SHADOW_OUTPUT)) {
+    if (setByte(_outputState & ~allRows) != 1) {
+      return 0;
+    }
+  }
+
+  // Per row: write CONFIG, Sr, aim the pointer at INPUT, Sr, read.
+  uint8_t numRead = 0;
+  for (uint8_t i = 0; i < numRows; i++) {
+    _configState = (_configState | allRows) & ~rowMasks[i];
+    if (!writeRegister(REG_CONFIG, _configState, false)
+        || !readRegister(REG_INPUT, _inputState, false)) {
+      break;
+    }
+    sense[i] = _inputState;
+    numRead++;
+  }
+
+  // Then Sr and make every row an input again, so none is left driving low
+  // between scans. This also moves the pointer off INPUT for the INT errata.
+  if (numRead == numRows) {
+    _configState |= allRows;
+    if (!writeRegister(REG_CONFIG, _configState)) {
+      numRead = 0;
+    }
+  }
+
+  if (numRead == numRows) {
+    _shadowValid |= SHADOW_CONFIG;
+    applyIntErrata();
+  } else {
+    _shadowValid &= ~SHADOW_CONFIG;
+  }
+  return numRead;
 }
 
 void I2CParallel9534::enableInputs(const uint8_t mask) {
@@ -117,26 +259,126 @@ void I2CParallel9534::enableInputs(const uint8_t mask) {
     return;
   }
 
-  // Write the specified input mask to the CONFIG register.
-  Wire.beginTransmission(_i2cAddr);
-  Wire.write(REG_CONFIG);
-  Wire.write(mask);
-  Wire.endTransmission(false);
-}
+  if (isShadowValid(SHADOW_CONFIG) && mask == _configState) {
+    return; // Pin directions are already set this way.
+  }
 
-void I2CParallel9534::waitForValid() {
-  // conservative delay (> 350ns hold time) to ensure propagation of output register to pins.
-  delayMicroseconds(I2C_PARALLEL_HOLD_TIME_MICROS);
+  // Write the specified input mask to the CONFIG register.
+  _configState = mask;
+  if (writeRegister(REG_CONFIG, mask)) {
+    _shadowValid |= SHADOW_CONFIG;
+  } else {
+    _shadowValid &= ~SHADOW_CONFIG;
+  }
 }
 
 void I2CParallel9534::setInputPolarity(const uint8_t polarity) {
-  _polarityState = polarity;
   if (_i2cAddr == UNINITIALIZED_I2C_ADDR) {
+    _polarityState = polarity;
     _error = I2C_PARALLEL_ERR_UNINITIALIZED;
     return;
   }
-  Wire.beginTransmission(_i2cAddr);
-  Wire.write(REG_POLARITY);
-  Wire.write(_polarityState);
-  Wire.endTransmission(SEND_STOP);
+
+  if (isShadowValid(SHADOW_POLARITY) && polarity == _polarityState) {
+    return; // Polarity register already holds this value.
+  }
+
+  _polarityState = polarity;
+  if (writeRegister(REG_POLARITY, polarity)) {
+    _shadowValid |= SHADOW_POLARITY;
+  } else {
+    _shadowValid &= ~SHADOW_POLARITY;
+  }
+}
+
+bool I2CParallel9534::resync() {
+  if (_i2cAddr == UNINITIALIZED_I2C_ADDR) {
+    _error = I2C_PARALLEL_ERR_UNINITIALIZED;
+    return false;
+  }
+
+  invalidateCache();
+  if (!readRegister(REG_OUTPUT, _outputState)) {
+    return false;
+  }
+  _shadowValid |= SHADOW_OUTPUT;
+  if (!readRegister(REG_CONFIG, _configState)) {
+    return false;
+  }
+  _shadowValid |= SHADOW_CONFIG;
+  if (!readRegister(REG_POLARITY, _polarityState)) {
+    return false;
+  }
+  _shadowValid |= SHADOW_POLARITY;
+  return true;
+}
+
+bool I2CParallel9534::restore() {
+  if (_i2cAddr == UNINITIALIZED_I2C_ADDR) {
+    _error = I2C_PARALLEL_ERR_UNINITIALIZED;
+    return false;
+  }
+
+  // The device holds its power-on defaults; only the registers we moved off
+  // them need rewriting. CONFIG goes last so no pin starts driving before its
+  // output level and drive settings are in place.
+  RegisterWrite writes[MAX_RESTORE_WRITES];
+  uint8_t n = 0;
+  if (_outputState != POWER_ON_OUTPUT) {
+    writes[n++] = { REG_OUTPUT, _outputState };
+  }
+  if (_polarityState != POWER_ON_POLARITY) {
+    writes[n++] = { REG_POLARITY, _polarityState };
+  }
+  n = addRestoreWrites(writes, n);
+  if (_configState != POWER_ON_CONFIG) {
+    writes[n++] = { REG_CONFIG, _configState };
+  }
+
+  // Each register is updated when its data byte is ACKed, so the writes can
+  // share one bus transaction, separated by repeated STARTs.
+  for (uint8_t i = 0; i < n; i++) {
+    if (!writeRegister(writes[i].reg, writes[i].val, i == n - 1)) {
+      invalidateCache();
+      return false;
+    }
+  }
+  _shadowValid = SHADOW_ALL;
+  return true;
+}
+
+bool I2CParallel9534::checkBrownout() {
+  if (_i2cAddr == UNINITIALIZED_I2C_ADDR) {
+    _error = I2C_PARALLEL_ERR_UNINITIALIZED;
+    return false;
+  }
+
+  // Pick a register whose expected contents differ from its power-on default.
+  uint8_t reg;
+  uint8_t expected;
+  if (isShadowValid(SHADOW_CONFIG) && _configState != POWER_ON_CONFIG) {
+    reg = REG_CONFIG;
+    expected = _configState;
+  } else if (isShadowValid(SHADOW_OUTPUT) && _outputState != POWER_ON_OUTPUT) {
+    reg = REG_OUTPUT;
+    expected = _outputState;
+  } else if (isShadowValid(SHADOW_POLARITY) && _polarityState != POWER_ON_POLARITY) {
+    reg = REG_POLARITY;
+    expected = _polarityState;
+  } else {
+    return false; // A reset device would look the same; nothing to recover.
+  }
+
+  // A reset device's register pointer is back on REG_INPUT; always re-aim it.
+  _regPointer = REG_POINTER_UNKNOWN;
+  uint8_t actual;
+  if (!readRegister(reg, actual) || actual == expected) {
+    return false;
+  }
+
+  if (_brownoutCount != UINT16_MAX) {
+    _brownoutCount++;
+  }
+  restore();
+  return true;
 }
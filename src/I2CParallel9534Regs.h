@@ -0,0 +1,28 @@
+// (c) Copyright 2026 Aaron Kimball
+// This library is licensed under the terms of the BSD 3-Clause license.
+// See the accompanying LICENSE.txt file for full license text.
+//
+// Register map of the PCA9534 / PCA9554 / PCA9538 / TCA6408A family, shared by
+// the I2CParallel9534 class drivers and the I2CParallelChip9534 protocol traits.
+// See datasheet: https://www.ti.com/lit/ds/symlink/pca9534.pdf
+
+#ifndef I2C_PARALLEL_9534_REGS_H
+#define I2C_PARALLEL_9534_REGS_H
+
+#include <stdint.h>
+
+// Register addresses for the command byte sent to the device.
+static constexpr uint8_t I2C_PCA9534_REG_INPUT = 0x00;
+static constexpr uint8_t I2C_PCA9534_REG_OUTPUT = 0x01;
+static constexpr uint8_t I2C_PCA9534_REG_POLARITY = 0x02;
+static constexpr uint8_t I2C_PCA9534_REG_CONFIG = 0x03;
+
+// Power-on register defaults.
+static constexpr uint8_t I2C_PCA9534_POWER_ON_OUTPUT = 0xFF;
+static constexpr uint8_t I2C_PCA9534_POWER_ON_POLARITY = 0x00;
+static constexpr uint8_t I2C_PCA9534_POWER_ON_CONFIG = 0xFF;
+
+// Driver-side value of the register pointer when its position is not known.
+static constexpr uint8_t I2C_PCA9534_REG_POINTER_UNKNOWN = 0xFF;
+
+#endif /* I2C_PARALLEL_9534_REGS_H */
@@ -31,6 +31,15 @@ void I2CParallel9538::reset() {
   digitalWrite(_resetPin, HIGH);
 
   _inputState = I2C_PARALLEL_STARTUP_INPUT_STATE;
+  _regPointer = REG_POINTER_UNKNOWN;
+  if (_restoreOnReset) {
+    restore();
+    return;
+  }
+
   _outputState = I2C_PARALLEL_STARTUP_INPUT_STATE;
   _polarityState = 0;
+  _configState = I2C_PARALLEL_STARTUP_INPUT_STATE;
+  // Every register is now at its known power-on default.
+  _shadowValid = SHADOW_ALL;
 }
@@ -0,0 +1,144 @@
+// (c) Copyright 2026 Aaron Kimball
+// This library is licensed under the terms of the BSD 3-Clause license.
+// See the accompanying LICENSE.txt file for full license text.
+//
+// I2CParallelAsync Implementation
+//
+// To use, include I2CParallelAsync.h, construct an I2CParallelAsync around an
+// init()'ed device, queue operations, and call poll() from loop().
+
+#include <Arduino.h>
+#include <cstdint>
+
+#include "I2CParallelAsync.h"
+
+static constexpr uint8_t OP_WRITE_OUTPUT = 0;
+static constexpr uint8_t OP_WRITE_INPUTS = 1;
+static constexpr uint8_t OP_READ = 2;
+
+static constexpr uint8_t ASYNC_INDEX_MASK = I2C_PARALLEL_ASYNC_QUEUE_LEN - 1;
+static_assert((I2C_PARALLEL_ASYNC_QUEUE_LEN & ASYNC_INDEX_MASK) == 0,
+    "I2C_PARALLEL_ASYNC_QUEUE_LEN must be a power of 2");
+
+I2CParallelAsync::I2CParallelAsync(I2CParallel& dev)
+    : _dev(dev), _head(0), _tail(0), _pendingOutput(dev.getLastOutputState()),
+      _numOutputWrites(0), _coalesced(0) {}
+
+bool I2CParallelAsync::push(const Op& op) {
+  if (size() >= I2C_PARALLEL_ASYNC_QUEUE_LEN) {
+    return false;
+  }
+  _ops[_head & ASYNC_INDEX_MASK] = op;
+  _head++;
+  return true;
+}
+
+bool I2CParallelAsync::changesOutput(const uint8_t kind) const {
+  return kind == OP_WRITE_OUTPUT || (kind == OP_WRITE_INPUTS && _dev.inputsUseOutputLatch());
+}
+
+bool I2CParallelAsync::queueWriteOp(const uint8_t kind, const uint8_t val) {
+  // Only the newest queued op can absorb the write. Anything else queued after
+  // an older write of this kind is a barrier: a read must observe the writes
+  // ahead of it, and a write of the other kind must stay in order (on a '8574
+  // both kinds write the same latch; on a '9534, reordering OUTPUT and CONFIG
+  // changes what the pins do in between).
+  if (!isEmpty()) {
+    Op& op = _ops[(uint8_t)(_head - 1) & ASYNC_INDEX_MASK];
+    if (op.kind == kind) {
+      // '8574 input enables accumulate, like the setOr() they turn into.
+      const bool accumulate = kind == OP_WRITE_INPUTS && _dev.inputsUseOutputLatch();
+      op.value = accumulate ? (op.value | val) : val;
+      _coalesced++;
+      return true;
+    }
+  }
+
+  const Op op = { kind, val, nullptr, nullptr, nullptr };
+  if (!push(op)) {
+    return false;
+  }
+  if (changesOutput(kind)) {
+    _numOutputWrites++;
+  }
+  return true;
+}
+
+bool I2CParallelAsync::queueWrite(const uint8_t val) {
+  if (!queueWriteOp(OP_WRITE_OUTPUT, val)) {
+    return false;
+  }
+  _pendingOutput = val;
+  return true;
+}
+
+bool I2CParallelAsync::queueEnableInputs(const uint8_t mask) {
+  const uint8_t output = getPendingOutput();
+  if (!queueWriteOp(OP_WRITE_INPUTS, mask)) {
+    return false;
+  }
+  if (_dev.inputsUseOutputLatch()) {
+    _pendingOutput = output | mask;
+  }
+  return true;
+}
+
+bool I2CParallelAsync::queueRead(I2CParallelReadHandle& handle) {
+  const Op op = { OP_READ, 0, &handle, nullptr, nullptr };
+  if (!push(op)) {
+    return false;
+  }
+  handle._state = I2CParallelReadHandle::STATE_PENDING;
+  return true;
+}
+
+bool I2CParallelAsync::queueRead(I2CParallelReadCallback callback, void* context) {
+  const Op op = { OP_READ, 0, nullptr, callback, context };
+  return push(op);
+}
+
+bool I2CParallelAsync::poll() {
+  if (isEmpty()) {
+    return false;
+  }
+
+  // Copy the op out and retire it before performing it, so a callback may queue more work.
+  const Op op = _ops[_tail & ASYNC_INDEX_MASK];
+  _tail++;
+  if (changesOutput(op.kind)) {
+    _numOutputWrites--;
+  }
+
+  switch (op.kind) {
+  case OP_WRITE_OUTPUT:
+    _dev.setByte(op.value);
+    break;
+  case OP_WRITE_INPUTS:
+    _dev.enableInputs(op.value);
+    break;
+  case OP_READ:
+  default: {
+    uint8_t nBytesRead = 0;
+    const uint8_t val = _dev.getByte(nBytesRead);
+    const bool ok = (nBytesRead == 1);
+    if (op.handle != nullptr) {
+      op.handle->_value = val;
+      op.handle->_state =
+          ok ? I2CParallelReadHandle::STATE_OK : I2CParallelReadHandle::STATE_FAILED;
+    }
+    if (op.callback != nullptr) {
+      op.callback(val, ok, op.context);
+    }
+    break;
+  }
+  }
+  return true;
+}
+
+uint8_t I2CParallelAsync::flush() {
+  uint8_t numPerformed = 0;
+  while (poll()) {
+    numPerformed++;
+  }
+  return numPerformed;
+}
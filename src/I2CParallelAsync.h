@@ -0,0 +1,125 @@
+// (c) Copyright 2026 Aaron Kimball
+// This library is licensed under the terms of the BSD 3-Clause license.
+// See the accompanying LICENSE.txt file for full license text.
+//
+// Queued, incrementally-serviced I/O for I2C parallel bus expanders.
+
+#ifndef I2C_PARALLEL_ASYNC_H
+#define I2C_PARALLEL_ASYNC_H
+
+#include "I2CParallel2.h"
+
+// Capacity of each I2CParallelAsync operation queue.
+static constexpr uint8_t I2C_PARALLEL_ASYNC_QUEUE_LEN = 8;
+
+class I2CParallelAsync;
+
+/**
+ * Completion handle for a queued read. The caller owns the handle, which must
+ * stay alive until the read completes.
+ */
+class I2CParallelReadHandle {
+public:
+  I2CParallelReadHandle() : _state(STATE_IDLE), _value(0){};
+
+  // True once the read has been performed (successfully or not).
+  bool isDone() const { return _state == STATE_OK || _state == STATE_FAILED; };
+  // True if the read completed successfully.
+  bool isOk() const { return _state == STATE_OK; };
+  // True while the read is waiting in the queue.
+  bool isPending() const { return _state == STATE_PENDING; };
+  // The value read. Only meaningful if isOk().
+  uint8_t value() const { return _value; };
+
+private:
+  static constexpr uint8_t STATE_IDLE = 0;
+  static constexpr uint8_t STATE_PENDING = 1;
+  static constexpr uint8_t STATE_OK = 2;
+  static constexpr uint8_t STATE_FAILED = 3;
+
+  volatile uint8_t _state;
+  uint8_t _value;
+
+  friend class I2CParallelAsync;
+};
+
+// Called from poll() when a queued read completes. `ok` is false on I/O error.
+typedef void (*I2CParallelReadCallback)(const uint8_t val, const bool ok, void* context);
+
+/**
+ * A fixed-capacity queue of I/O operations for one device, serviced by poll().
+ *
+ * The queueing calls return immediately. Each poll() performs at most one
+ * queued operation, i.e. one driver call, so a control loop can bound the time
+ * it spends on I2C I/O per iteration. A call may still be several bus
+ * transactions: a '9534 getByte() sends the command byte and then reads, and
+ * the interrupt errata write or a retry policy adds more. (The Arduino Wire
+ * API has no portable non-blocking master transfer, so each transaction
+ * itself still runs to completion inside poll().)
+ *
+ * Queued writes coalesce: a write queued right behind a queued write of the
+ * same kind replaces its value, so only the newest value goes out. Any other
+ * queued operation is a barrier: a read must observe the writes ahead of it,
+ * and output and input-enable writes keep their relative order (on a '8574
+ * both change the same latch). No heap memory is used.
+ */
+class I2CParallelAsync {
+public:
+  explicit I2CParallelAsync(I2CParallel& dev);
+  ~I2CParallelAsync(){};
+
+  // Queue a setByte(). Returns false if the queue is full.
+  bool queueWrite(const uint8_t val);
+  // Queue an enableInputs(). Returns false if the queue is full.
+  bool queueEnableInputs(const uint8_t mask);
+  // Queue a getByte() whose result is reported through `handle`.
+  bool queueRead(I2CParallelReadHandle& handle);
+  // Queue a getByte() whose result is passed to `callback`.
+  bool queueRead(I2CParallelReadCallback callback, void* context = nullptr);
+
+  // The output state as of the newest queued write (or the device's current
+  // output state if no write is queued). On a '8574 this includes the bits
+  // set by queued input enables. Use this to compose bit-level updates.
+  uint8_t getPendingOutput() const {
+    return _numOutputWrites != 0 ? _pendingOutput : _dev.getLastOutputState();
+  };
+
+  // Perform the oldest queued operation, if any. Returns true if an operation
+  // was performed.
+  bool poll();
+  // Perform every queued operation. Returns the number performed.
+  uint8_t flush();
+
+  uint8_t size() const { return (uint8_t)(_head - _tail); };
+  bool isEmpty() const { return _head == _tail; };
+
+  I2CParallel& device() const { return _dev; };
+
+  // Number of queued writes absorbed into an already-queued write.
+  uint16_t getCoalescedCount() const { return _coalesced; };
+
+private:
+  struct Op {
+    uint8_t kind;
+    uint8_t value;
+    I2CParallelReadHandle* handle;
+    I2CParallelReadCallback callback;
+    void* context;
+  };
+
+  // Coalesce into a queued write of `kind`, or append a new op.
+  bool queueWriteOp(const uint8_t kind, const uint8_t val);
+  // Return true if performing an op of `kind` changes the output state.
+  bool changesOutput(const uint8_t kind) const;
+  bool push(const Op& op);
+
+  I2CParallel& _dev;
+  Op _ops[I2C_PARALLEL_ASYNC_QUEUE_LEN];
+  uint8_t _head; // Free-running write index.
+  uint8_t _tail; // Free-running read index.
+  uint8_t _pendingOutput;   // Output state once the queued writes are done.
+  uint8_t _numOutputWrites; // Queued ops that change the output state.
+  uint16_t _coalesced;
+};
+
+#endif /* I2C_PARALLEL_ASYNC_H */
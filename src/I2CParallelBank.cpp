@@ -0,0 +1,167 @@
+// (c) Copyright 2026 Aaron Kimball
+// This library is licensed under the terms of the BSD 3-Clause license.
+// See the accompanying LICENSE.txt file for full license text.
+//
+// I2CParallelBank Implementation
+//
+// To use, include I2CParallelBank.h, init() each device, and construct an
+// I2CParallelBank over an array of device pointers.
+
+#include <Arduino.h>
+#include <cstdint>
+
+#include "I2CParallelBank.h"
+
+static constexpr uint8_t BITS_PER_DEVICE = 8;
+
+I2CParallelBank::I2CParallelBank(I2CParallel* const* devices, const uint8_t numDevices)
+    : _numDevices(numDevices > I2C_PARALLEL_BANK_MAX_DEVICES ? I2C_PARALLEL_BANK_MAX_DEVICES
+                                                             : numDevices),
+      _dirty(0), _lastFlushSkew(0), _lastFlushMicros(0), _lastReadMicros(0) {
+  for (uint8_t i = 0; i < _numDevices; i++) {
+    _devices[i] = devices[i];
+    _pending[i] = devices[i]->getLastOutputState();
+    _inputs[i] = devices[i]->getLastInputState();
+    _order[i] = i;
+  }
+}
+
+void I2CParallelBank::setPending(const uint8_t idx, const uint8_t val) {
+  if (_pending[idx] != val) {
+    _pending[idx] = val;
+    _dirty |= (uint16_t)(1 << idx);
+  }
+}
+
+void I2CParallelBank::setPin(const uint16_t pin) {
+  if (pin >= numPins()) {
+    return;
+  }
+  const uint8_t idx = pin / BITS_PER_DEVICE;
+  setPending(idx, _pending[idx] | (1 << (pin % BITS_PER_DEVICE)));
+}
+
+void I2CParallelBank::clrPin(const uint16_t pin) {
+  if (pin >= numPins()) {
+    return;
+  }
+  const uint8_t idx = pin / BITS_PER_DEVICE;
+  setPending(idx, _pending[idx] & ~(1 << (pin % BITS_PER_DEVICE)));
+}
+
+void I2CParallelBank::togglePin(const uint16_t pin) {
+  if (pin >= numPins()) {
+    return;
+  }
+  const uint8_t idx = pin / BITS_PER_DEVICE;
+  setPending(idx, _pending[idx] ^ (1 << (pin % BITS_PER_DEVICE)));
+}
+
+void I2CParallelBank::writePin(const uint16_t pin, const bool val) {
+  if (val) {
+    setPin(pin);
+  } else {
+    clrPin(pin);
+  }
+}
+
+void I2CParallelBank::setPins(const uint8_t* mask) {
+  for (uint8_t i = 0; i < _numDevices; i++) {
+    setPending(i, _pending[i] | mask[i]);
+  }
+}
+
+void I2CParallelBank::clrPins(const uint8_t* mask) {
+  for (uint8_t i = 0; i < _numDevices; i++) {
+    setPending(i, _pending[i] & ~mask[i]);
+  }
+}
+
+void I2CParallelBank::togglePins(const uint8_t* mask) {
+  for (uint8_t i = 0; i < _numDevices; i++) {
+    setPending(i, _pending[i] ^ mask[i]);
+  }
+}
+
+void I2CParallelBank::writeAll(const uint8_t* vals) {
+  for (uint8_t i = 0; i < _numDevices; i++) {
+    setPending(i, vals[i]);
+  }
+}
+
+bool I2CParallelBank::getOutputPin(const uint16_t pin) const {
+  if (pin >= numPins()) {
+    return false;
+  }
+  return (_pending[pin / BITS_PER_DEVICE] & (1 << (pin % BITS_PER_DEVICE))) != 0;
+}
+
+bool I2CParallelBank::getInputPin(const uint16_t pin) const {
+  if (pin >= numPins()) {
+    return false;
+  }
+  return (_inputs[pin / BITS_PER_DEVICE] & (1 << (pin % BITS_PER_DEVICE))) != 0;
+}
+
+void I2CParallelBank::sortByAddress() {
+  // Insertion sort; there are at most 16 devices. Addresses are only known
+  // after each device's init(), so this is redone on each pass over the bank.
+  for (uint8_t i = 1; i < _numDevices; i++) {
+    const uint8_t idx = _order[i];
+    const uint8_t addr = _devices[idx]->getAddress();
+    int8_t j = i - 1;
+    while (j >= 0 && _devices[_order[j]]->getAddress() > addr) {
+      _order[j + 1] = _order[j];
+      j--;
+    }
+    _order[j + 1] = idx;
+  }
+}
+
+uint8_t I2CParallelBank::flush() {
+  const uint32_t start = micros();
+  uint32_t firstDone = start;
+  uint32_t lastDone = start;
+  uint8_t numWritten = 0;
+
+  sortByAddress();
+  for (uint8_t i = 0; i < _numDevices && _dirty != 0; i++) {
+    const uint8_t idx = _order[i];
+    const uint16_t bit = (uint16_t)(1 << idx);
+    if ((_dirty & bit) == 0) {
+      continue;
+    }
+    if (_devices[idx]->setByte(_pending[idx]) == 1) {
+      _dirty &= ~bit;
+      lastDone = micros();
+      if (numWritten++ == 0) {
+        firstDone = lastDone;
+      }
+    }
+  }
+
+  _lastFlushSkew = lastDone - firstDone;
+  _lastFlushMicros = micros() - start;
+  return numWritten;
+}
+
+uint8_t I2CParallelBank::readInputs(uint8_t* dest) {
+  const uint32_t start = micros();
+  uint8_t numRead = 0;
+
+  sortByAddress();
+  for (uint8_t i = 0; i < _numDevices; i++) {
+    const uint8_t idx = _order[i];
+    uint8_t nBytesRead = 0;
+    _inputs[idx] = _devices[idx]->getByte(nBytesRead);
+    numRead += nBytesRead;
+  }
+
+  if (dest != nullptr) {
+    for (uint8_t i = 0; i < _numDevices; i++) {
+      dest[i] = _inputs[i];
+    }
+  }
+  _lastReadMicros = micros() - start;
+  return numRead;
+}
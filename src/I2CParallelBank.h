@@ -0,0 +1,95 @@
+// (c) Copyright 2026 Aaron Kimball
+// This library is licensed under the terms of the BSD 3-Clause license.
+// See the accompanying LICENSE.txt file for full license text.
+//
+// Treat several I2C parallel bus expanders as a single wide port.
+
+#ifndef I2C_PARALLEL_BANK_H
+#define I2C_PARALLEL_BANK_H
+
+#include "I2CParallel2.h"
+
+// A bank can hold up to 16 devices: e.g., 8 PCF8574 plus 8 PCF8574A (128 pins).
+static constexpr uint8_t I2C_PARALLEL_BANK_MAX_DEVICES = 16;
+
+/**
+ * A bank of up to 16 I2CParallel devices driven as one wide port.
+ *
+ * Pins are numbered across the bank in the order the devices were given:
+ * pin `p` is bit `p % 8` of device `p / 8`. Pin operations only update the
+ * bank's pending output state; flush() then writes just the devices whose
+ * bytes changed, back-to-back in I2C address order. readInputs() fetches
+ * every device's input state in one pass.
+ *
+ * Each device must be init()'ed by the caller. The bank does not take
+ * ownership of the devices themselves.
+ */
+class I2CParallelBank {
+public:
+  I2CParallelBank(I2CParallel* const* devices, const uint8_t numDevices);
+  ~I2CParallelBank(){};
+
+  uint8_t size() const { return _numDevices; };
+  uint16_t numPins() const { return (uint16_t)_numDevices * 8; };
+  I2CParallel* device(const uint8_t idx) const {
+    return idx < _numDevices ? _devices[idx] : nullptr;
+  };
+
+  /** Set, clear, toggle, or assign a single pin of the pending output state. */
+  void setPin(const uint16_t pin);
+  void clrPin(const uint16_t pin);
+  void togglePin(const uint16_t pin);
+  void writePin(const uint16_t pin, const bool val);
+
+  // Apply a packed bit array (one byte per device) to the pending output state.
+  void setPins(const uint8_t* mask);
+  void clrPins(const uint8_t* mask);
+  void togglePins(const uint8_t* mask);
+  void writeAll(const uint8_t* vals);
+
+  // Pending output state of a pin, or of a whole device.
+  bool getOutputPin(const uint16_t pin) const;
+  uint8_t getOutputByte(const uint8_t idx) const { return idx < _numDevices ? _pending[idx] : 0; };
+
+  // Return true if flush() has writes to perform.
+  bool isDirty() const { return _dirty != 0; };
+
+  // Write the pending state of every changed device. Returns the number of
+  // devices written. A device whose write fails stays dirty for the next flush.
+  uint8_t flush();
+
+  // Read every device's inputs, in address order. If `dest` is non-null, it
+  // receives the packed input state (one byte per device). Returns the number
+  // of devices read successfully.
+  uint8_t readInputs(uint8_t* dest = nullptr);
+
+  // Input state of a pin, or of a whole device, as of the last readInputs().
+  bool getInputPin(const uint16_t pin) const;
+  uint8_t getInputByte(const uint8_t idx) const { return idx < _numDevices ? _inputs[idx] : 0; };
+
+  // Statistics for the last flush(): the time between the first and last
+  // device write completing (output skew across the bank), and the total
+  // micros() spent in flush().
+  uint32_t getLastFlushSkewMicros() const { return _lastFlushSkew; };
+  uint32_t getLastFlushMicros() const { return _lastFlushMicros; };
+  // Total micros() spent in the last readInputs().
+  uint32_t getLastReadMicros() const { return _lastReadMicros; };
+
+private:
+  // Fill _order with device indices sorted by I2C address.
+  void sortByAddress();
+  void setPending(const uint8_t idx, const uint8_t val);
+
+  I2CParallel* _devices[I2C_PARALLEL_BANK_MAX_DEVICES];
+  uint8_t _order[I2C_PARALLEL_BANK_MAX_DEVICES];
+  uint8_t _pending[I2C_PARALLEL_BANK_MAX_DEVICES];
+  uint8_t _inputs[I2C_PARALLEL_BANK_MAX_DEVICES];
+  uint8_t _numDevices;
+  uint16_t _dirty; // Bit i set if device i has pending output to write.
+
+  uint32_t _lastFlushSkew;
+  uint32_t _lastFlushMicros;
+  uint32_t _lastReadMicros;
+};
+
+#endif /* I2C_PARALLEL_BANK_H */
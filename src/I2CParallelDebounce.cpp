@@ -0,0 +1,153 @@
+// (c) Copyright 2026 Aaron Kimball
+// This library is licensed under the terms of the BSD 3-Clause license.
+// See the accompanying LICENSE.txt file for full license text.
+//
+// I2CParallelDebounce Implementation
+//
+// To use, include I2CParallelDebounce.h, construct an I2CParallelDebounce over
+// an array of init()'ed devices, and call sample() at a fixed interval.
+
+#include <Arduino.h>
+#include <cstdint>
+
+#include "I2CParallelDebounce.h"
+
+static constexpr uint8_t BITS_PER_DEVICE = 8;
+static constexpr uint8_t MAX_PLANES = 4;
+
+I2CParallelDebounce::I2CParallelDebounce(
+    I2CParallel* const* devices, const uint8_t numDevices, const uint8_t depth)
+    : _numLanes(numDevices > I2C_PARALLEL_DEBOUNCE_MAX_DEVICES ? I2C_PARALLEL_DEBOUNCE_MAX_DEVICES
+                                                               : numDevices),
+      _activeLow(true) {
+  for (uint8_t i = 0; i < _numLanes; i++) {
+    _devices[i] = devices[i];
+  }
+  setDepth(depth);
+  reset();
+}
+
+I2CParallelDebounce::I2CParallelDebounce(const uint8_t numLanes, const uint8_t depth)
+    : _numLanes(numLanes > I2C_PARALLEL_DEBOUNCE_MAX_DEVICES ? I2C_PARALLEL_DEBOUNCE_MAX_DEVICES
+                                                             : numLanes),
+      _activeLow(true) {
+  for (uint8_t i = 0; i < _numLanes; i++) {
+    _devices[i] = nullptr;
+  }
+  setDepth(depth);
+  reset();
+}
+
+void I2CParallelDebounce::setDepth(const uint8_t depth) {
+  if (depth == 0) {
+    _depth = 1;
+  } else if (depth > I2C_PARALLEL_DEBOUNCE_MAX_DEPTH) {
+    _depth = I2C_PARALLEL_DEBOUNCE_MAX_DEPTH;
+  } else {
+    _depth = depth;
+  }
+  _numPlanes = 0;
+  while (_numPlanes < MAX_PLANES && (_depth >> _numPlanes) != 0) {
+    _numPlanes++;
+  }
+  for (uint8_t p = 0; p < MAX_PLANES; p++) {
+    for (uint8_t i = 0; i < _numLanes; i++) {
+      _counts[p][i] = 0;
+    }
+  }
+}
+
+void I2CParallelDebounce::reset(const uint8_t* state) {
+  for (uint8_t i = 0; i < _numLanes; i++) {
+    if (state != nullptr) {
+      _state[i] = state[i];
+    } else {
+      _state[i] = _devices[i] != nullptr ? _devices[i]->getLastInputState()
+                                         : I2C_PARALLEL_STARTUP_INPUT_STATE;
+    }
+    _changed[i] = 0;
+    for (uint8_t p = 0; p < MAX_PLANES; p++) {
+      _counts[p][i] = 0;
+    }
+  }
+  _changedLanes = 0;
+}
+
+void I2CParallelDebounce::updateLane(const uint8_t idx, const uint8_t sample) {
+  // Count up the counters of pins that disagree with their debounced state
+  // (a bit-sliced ripple-carry increment) and zero the rest. `reached` ends up
+  // holding the pins whose count now equals _depth.
+  const uint8_t delta = sample ^ _state[idx];
+  uint8_t carry = delta;
+  uint8_t reached = delta;
+  for (uint8_t p = 0; p < _numPlanes; p++) {
+    const uint8_t bit = _counts[p][idx];
+    const uint8_t next = (bit ^ carry) & delta;
+    carry &= bit;
+    _counts[p][idx] = next;
+    reached &= ((_depth >> p) & 1) ? next : (uint8_t)~next;
+  }
+
+  if (reached != 0) {
+    _state[idx] ^= reached;
+    for (uint8_t p = 0; p < _numPlanes; p++) {
+      _counts[p][idx] &= ~reached;
+    }
+    _changedLanes |= (uint16_t)(1 << idx);
+  }
+  _changed[idx] = reached;
+}
+
+void I2CParallelDebounce::update(const uint8_t* samples) {
+  _changedLanes = 0;
+  for (uint8_t i = 0; i < _numLanes; i++) {
+    updateLane(i, samples[i]);
+  }
+}
+
+void I2CParallelDebounce::useLastInputs() {
+  _changedLanes = 0;
+  for (uint8_t i = 0; i < _numLanes; i++) {
+    if (_devices[i] != nullptr) {
+      updateLane(i, _devices[i]->getLastInputState());
+    } else {
+      _changed[i] = 0; // No new sample, so no edges this update.
+    }
+  }
+}
+
+uint8_t I2CParallelDebounce::sample() {
+  uint8_t numRead = 0;
+  _changedLanes = 0;
+  for (uint8_t i = 0; i < _numLanes; i++) {
+    if (_devices[i] == nullptr) {
+      _changed[i] = 0; // No new sample, so no edges this update.
+      continue;
+    }
+    uint8_t nBytesRead = 0;
+    updateLane(i, _devices[i]->getByte(nBytesRead));
+    numRead += nBytesRead;
+  }
+  return numRead;
+}
+
+bool I2CParallelDebounce::getPin(const uint16_t pin) const {
+  if (pin >= (uint16_t)_numLanes * BITS_PER_DEVICE) {
+    return false;
+  }
+  return (_state[pin / BITS_PER_DEVICE] >> (pin % BITS_PER_DEVICE)) & 1;
+}
+
+uint8_t I2CParallelDebounce::getPressed(const uint8_t idx) const {
+  if (idx >= _numLanes) {
+    return 0;
+  }
+  return _changed[idx] & (_activeLow ? ~_state[idx] : _state[idx]);
+}
+
+uint8_t I2CParallelDebounce::getReleased(const uint8_t idx) const {
+  if (idx >= _numLanes) {
+    return 0;
+  }
+  return _changed[idx] & (_activeLow ? _state[idx] : ~_state[idx]);
+}
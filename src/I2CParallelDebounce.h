@@ -0,0 +1,96 @@
+// (c) Copyright 2026 Aaron Kimball
+// This library is licensed under the terms of the BSD 3-Clause license.
+// See the accompanying LICENSE.txt file for full license text.
+//
+// Bit-parallel input debouncing for I2C parallel bus expanders.
+
+#ifndef I2C_PARALLEL_DEBOUNCE_H
+#define I2C_PARALLEL_DEBOUNCE_H
+
+#include "I2CParallel2.h"
+
+// Devices (8-pin lanes) one debouncer can hold; matches I2CParallelBank.
+static constexpr uint8_t I2C_PARALLEL_DEBOUNCE_MAX_DEVICES = 16;
+
+// Vertical counters are 4 bits deep, so a pin can be required to hold a new
+// level for up to 15 consecutive samples.
+static constexpr uint8_t I2C_PARALLEL_DEBOUNCE_MAX_DEPTH = 15;
+static constexpr uint8_t I2C_PARALLEL_DEBOUNCE_DEFAULT_DEPTH = 4;
+
+/**
+ * Debounces every pin of up to 16 devices with vertical counters.
+ *
+ * Each pin has a small counter of the consecutive samples that disagree with
+ * its debounced state. Bit `b` of every pin's counter is stored in one byte per
+ * device ("vertical" layout), so all 8 pins of a device are counted with a
+ * handful of bitwise operations; a pin's debounced state flips once its input
+ * has disagreed for `depth` samples in a row, and any agreeing sample resets
+ * its count. The cost per sample is the same whether 1 or 8 pins are bouncing.
+ *
+ * Samples come from the devices themselves (sample() calls getByte() on each;
+ * useLastInputs() takes getLastInputState(), for inputs already read by e.g.
+ * an I2CParallelBank or I2CParallelEvents), or from a packed array of one byte
+ * per device (update()). Call one of them at a fixed interval, e.g. every 5 ms.
+ */
+class I2CParallelDebounce {
+public:
+  // Debounce the inputs of `devices`. The debounced state starts as each
+  // device's last input state.
+  I2CParallelDebounce(I2CParallel* const* devices, const uint8_t numDevices,
+      const uint8_t depth = I2C_PARALLEL_DEBOUNCE_DEFAULT_DEPTH);
+  // Debounce `numLanes` bytes of packed input given to update().
+  explicit I2CParallelDebounce(
+      const uint8_t numLanes, const uint8_t depth = I2C_PARALLEL_DEBOUNCE_DEFAULT_DEPTH);
+  ~I2CParallelDebounce(){};
+
+  uint8_t size() const { return _numLanes; };
+
+  // Samples a pin must disagree for before its debounced state changes
+  // (1--15; 1 disables debouncing). Clears all counters.
+  void setDepth(const uint8_t depth);
+  uint8_t getDepth() const { return _depth; };
+
+  // Pins are active-low (e.g. buttons to ground, the default) or active-high.
+  // This decides which edge getPressed() vs. getReleased() reports.
+  void setActiveLow(const bool activeLow) { _activeLow = activeLow; };
+
+  // Set the debounced state of every lane and clear the counters. If `state`
+  // is null, each device's last input state is used.
+  void reset(const uint8_t* state = nullptr);
+
+  // Read every device with getByte() and update. A device whose read fails is
+  // sampled at its last known input state. Returns the number of devices read.
+  // Lanes without a device keep their state and report no edges.
+  uint8_t sample();
+  // Update from each device's getLastInputState(), without bus I/O. Lanes
+  // without a device are handled as in sample().
+  void useLastInputs();
+  // Update from a packed array of one input byte per lane.
+  void update(const uint8_t* samples);
+
+  // Debounced input state of a lane or a pin.
+  uint8_t getState(const uint8_t idx) const { return idx < _numLanes ? _state[idx] : 0; };
+  bool getPin(const uint16_t pin) const;
+
+  // Pins whose debounced state became pressed / released in the last update.
+  uint8_t getPressed(const uint8_t idx) const;
+  uint8_t getReleased(const uint8_t idx) const;
+  // Return true if any pin changed debounced state in the last update.
+  bool hasChanged() const { return _changedLanes != 0; };
+
+private:
+  void updateLane(const uint8_t idx, const uint8_t sample);
+
+  I2CParallel* _devices[I2C_PARALLEL_DEBOUNCE_MAX_DEVICES];
+  uint8_t _state[I2C_PARALLEL_DEBOUNCE_MAX_DEVICES];
+  uint8_t _changed[I2C_PARALLEL_DEBOUNCE_MAX_DEVICES]; // Debounced edges, last update.
+  // _counts[b][i]: bit b of the counters for the pins of lane i.
+  uint8_t _counts[4][I2C_PARALLEL_DEBOUNCE_MAX_DEVICES];
+  uint8_t _numLanes;
+  uint8_t _depth;
+  uint8_t _numPlanes; // Counter bits in use: enough to count to _depth.
+  bool _activeLow;
+  uint16_t _changedLanes; // Bit i set if lane i has edges in _changed.
+};
+
+#endif /* I2C_PARALLEL_DEBOUNCE_H */
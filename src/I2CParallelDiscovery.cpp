@@ -0,0 +1,166 @@
+// (c) Copyright 2026 Aaron Kimball
+// This library is licensed under the terms of the BSD 3-Clause license.
+// See the accompanying LICENSE.txt file for full license text.
+//
+// I2CParallelDiscovery Implementation
+//
+// To use, include I2CParallelDiscovery.h, declare driver arrays for an
+// I2CParallelPool, and call discover() once at startup.
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <cstdint>
+
+#include "I2CParallelDiscovery.h"
+
+// The '9534 registers read by classify(), in order. Each command byte only
+// moves a '9534's register pointer; a PCF8574 latches it onto its pins instead.
+// CONFIG goes first: a PCF8574 then holds pins 0 and 1 released for every
+// probe, so their levels must read back the same each time.
+static constexpr uint8_t PROBE_REGS[] = { I2C_PCA9534_REG_CONFIG, I2C_PCA9534_REG_POLARITY,
+  I2C_PCA9534_REG_OUTPUT };
+
+uint8_t I2CParallelDiscovery::chipAt(const uint8_t addr) const {
+  for (uint8_t i = 0; i < _numFound; i++) {
+    if (_found[i].addr == addr) {
+      return _found[i].chip;
+    }
+  }
+  return I2C_PARALLEL_CHIP_NONE;
+}
+
+bool I2CParallelDiscovery::probe(const uint8_t addr) {
+  _wire->beginTransmission(addr);
+  return _wire->endTransmission(true) == 0;
+}
+
+bool I2CParallelDiscovery::readByte(const uint8_t addr, uint8_t& val) {
+  if (_wire->requestFrom(addr, (uint8_t)1) != 1) {
+    return false;
+  }
+  val = _wire->read();
+  return true;
+}
+
+bool I2CParallelDiscovery::readRegister(const uint8_t addr, const uint8_t reg, uint8_t& val) {
+  _wire->beginTransmission(addr);
+  _wire->write(reg);
+  if (_wire->endTransmission(false) != 0) { // Repeated start, no STOP
+    return false;
+  }
+  return readByte(addr, val);
+}
+
+uint8_t I2CParallelDiscovery::classify(const uint8_t addr) {
+  // A read without a command byte changes neither chip: a PCF8574 returns its
+  // pin levels, a '9534 whichever register its pointer selects.
+  uint8_t before;
+  if (!readByte(addr, before)) {
+    return I2C_PARALLEL_CHIP_NONE;
+  }
+
+  // A PCF8574 that has latched the command byte `reg` drives the other pins
+  // low and releases the pins in `reg` (quasi-bidirectional), so it can only
+  // read back bits of `reg`. A released pin that read high before still does,
+  // and one that is released for every probe reads the same level each time.
+  // A '9534 returns its register, which is seldom that consistent; stop at the
+  // first value that the PCF8574 could not have returned.
+  uint8_t released = 0;
+  for (const uint8_t reg : PROBE_REGS) {
+    uint8_t val;
+    if (!readRegister(addr, reg, val)) {
+      return I2C_PARALLEL_CHIP_NONE;
+    }
+    if (reg == I2C_PCA9534_REG_CONFIG) {
+      released = val;
+      if ((val & ~reg) != 0 || (before & reg & ~val) != 0) {
+        return I2C_PARALLEL_CHIP_9534;
+      }
+    } else if (val != (released & reg)) {
+      return I2C_PARALLEL_CHIP_9534;
+    }
+  }
+
+  // A PCF8574: put back the pin levels it had before the probes.
+  _wire->beginTransmission(addr);
+  _wire->write(before);
+  _wire->endTransmission(true);
+  return I2C_PARALLEL_CHIP_8574;
+}
+
+void I2CParallelDiscovery::probeRange(
+    const uint8_t minAddr, const uint8_t maxAddr, const bool shared) {
+  for (uint8_t addr = minAddr; addr <= maxAddr; addr++) {
+    if (_numFound == I2C_PARALLEL_DISCOVERY_MAX_DEVICES || !probe(addr)) {
+      continue;
+    }
+    const uint8_t chip = shared ? classify(addr) : I2C_PARALLEL_CHIP_9538;
+    if (chip != I2C_PARALLEL_CHIP_NONE) {
+      _found[_numFound++] = { addr, chip };
+    }
+  }
+}
+
+void I2CParallelDiscovery::configureBus(const uint32_t busSpeed, const uint32_t wireTimeout) {
+  _wire->setClock(busSpeed);
+#if defined(ARDUINO_ARCH_SAMD) || defined(ARDUINO_TEENSY41)
+  _wire->setTimeout(wireTimeout);
+#else
+  _wire->setWireTimeout(wireTimeout, true);
+#endif
+}
+
+uint8_t I2CParallelDiscovery::scan(const uint32_t busSpeed, const uint32_t wireTimeout) {
+  const uint32_t start = micros();
+  _numFound = 0;
+
+  configureBus(I2C_PARALLEL_MAX_BUS_SPEED, I2C_PARALLEL_DISCOVERY_WIRE_TIMEOUT);
+
+  // The PCF8574 and '9534 families share the same two address ranges.
+  probeRange(I2C_PCF8574_MIN_ADDR, I2C_PCF8574_MAX_ADDR, true);
+  probeRange(I2C_PCF8574A_MIN_ADDR, I2C_PCF8574A_MAX_ADDR, true);
+  probeRange(I2C_PCA9538_MIN_ADDR, I2C_PCA9538_MAX_ADDR, false);
+
+  // Other devices on the bus may rely on the normal settings.
+  configureBus(busSpeed, wireTimeout);
+
+  _lastScanMicros = micros() - start;
+  return _numFound;
+}
+
+uint8_t I2CParallelDiscovery::build(const I2CParallelPool& pool, I2CParallel** devices,
+    const uint8_t maxDevices, const uint32_t busSpeed) {
+  uint8_t num8574 = 0;
+  uint8_t num9534 = 0;
+  uint8_t num9538 = 0;
+  uint8_t numBuilt = 0;
+
+  for (uint8_t i = 0; i < _numFound && numBuilt < maxDevices; i++) {
+    I2CParallel* dev = nullptr;
+    switch (_found[i].chip) {
+    case I2C_PARALLEL_CHIP_8574:
+      if (num8574 < pool.num8574) {
+        dev = &pool.pcf8574[num8574++];
+      }
+      break;
+    case I2C_PARALLEL_CHIP_9534:
+      if (num9534 < pool.num9534) {
+        dev = &pool.pca9534[num9534++];
+      }
+      break;
+    case I2C_PARALLEL_CHIP_9538:
+      if (num9538 < pool.num9538) {
+        dev = &pool.pca9538[num9538++];
+      }
+      break;
+    default:
+      break;
+    }
+    if (dev == nullptr) {
+      continue; // No free driver of this family.
+    }
+    dev->init(_found[i].addr, busSpeed);
+    devices[numBuilt++] = dev;
+  }
+  return numBuilt;
+}
@@ -0,0 +1,121 @@
+// (c) Copyright 2026 Aaron Kimball
+// This library is licensed under the terms of the BSD 3-Clause license.
+// See the accompanying LICENSE.txt file for full license text.
+//
+// Find the I2C parallel bus expanders on a bus and build drivers for them.
+
+#ifndef I2C_PARALLEL_DISCOVERY_H
+#define I2C_PARALLEL_DISCOVERY_H
+
+#include "I2CParallel2.h"
+
+// Chip families told apart by I2CParallelDiscovery.
+static constexpr uint8_t I2C_PARALLEL_CHIP_NONE = 0;
+static constexpr uint8_t I2C_PARALLEL_CHIP_8574 = 1; // PCF8574 / PCF8574A
+static constexpr uint8_t I2C_PARALLEL_CHIP_9534 = 2; // PCA9534 / 9534A / 9554 / TCA6408A
+static constexpr uint8_t I2C_PARALLEL_CHIP_9538 = 3; // PCA9538
+
+// 0x20--0x27, 0x38--0x3F and 0x70--0x73.
+static constexpr uint8_t I2C_PARALLEL_DISCOVERY_MAX_DEVICES = 20;
+
+// Wire timeout used while probing, so a wedged address cannot stall the scan.
+static constexpr uint32_t I2C_PARALLEL_DISCOVERY_WIRE_TIMEOUT = 1000;
+
+/** One device found by I2CParallelDiscovery::scan(). */
+struct I2CParallelFound {
+  uint8_t addr;
+  uint8_t chip; // I2C_PARALLEL_CHIP_*
+};
+
+/**
+ * Driver objects for I2CParallelDiscovery::build() to assign to the devices it
+ * finds, in I2C address order within each family. The arrays are owned by the
+ * caller (typically as globals) and must use the controller being scanned.
+ * '9538 drivers are constructed with their RESET_L pins (or INVALID_GPIO_PIN).
+ */
+struct I2CParallelPool {
+  I2CParallel8574* pcf8574;
+  uint8_t num8574;
+  I2CParallel9534* pca9534;
+  uint8_t num9534;
+  I2CParallel9538* pca9538;
+  uint8_t num9538;
+};
+
+/**
+ * Enumerates the expanders on one I2C controller.
+ *
+ * scan() sends a zero-length write to each candidate address at 400 kHz; only
+ * the addresses that ACK are looked at further. The PCF8574 and the '9534
+ * family share 0x20--0x27 and 0x38--0x3F, so a device there is first read
+ * without a command byte (which changes neither chip), and then sent the
+ * CONFIG, POLARITY and OUTPUT command bytes, each followed by a read. A '9534
+ * only moves its register pointer and returns its registers. A PCF8574
+ * latches each command byte onto its pins, so it can only read back bits of
+ * the command byte, consistent with its pin levels; the first read that does
+ * not fit identifies a '9534, whatever its configuration. A PCF8574 is then
+ * given back the pin levels of the first read. Its pins 2--7 are driven low
+ * for the ~270us the probes take at 400 kHz.
+ *
+ * A '9534 is only mistaken for a PCF8574 if its CONFIG, POLARITY and OUTPUT
+ * registers all read back as a PCF8574 would: e.g. every pin an output
+ * driven low, with no input inversion.
+ *
+ * Devices at 0x70--0x73 are PCA9538s; no other supported family uses them.
+ */
+class I2CParallelDiscovery {
+public:
+  explicit I2CParallelDiscovery(TwoWire& wire = Wire)
+      : _wire(&wire), _numFound(0), _lastScanMicros(0){};
+  ~I2CParallelDiscovery(){};
+
+  // Probe every candidate address and identify what answers. Returns the
+  // number of devices found. The Wire API cannot report the controller's
+  // clock or timeout, so give the settings the bus normally runs at: scan()
+  // puts them back before it returns.
+  uint8_t scan(const uint32_t busSpeed = I2C_PARALLEL_MAX_BUS_SPEED,
+      const uint32_t wireTimeout = I2C_PARALLEL_WIRE_TIMEOUT);
+
+  // Devices found by the last scan(), in address order.
+  uint8_t size() const { return _numFound; };
+  const I2CParallelFound* found() const { return _found; };
+  // The chip family at `addr`, or I2C_PARALLEL_CHIP_NONE.
+  uint8_t chipAt(const uint8_t addr) const;
+
+  // init() a driver from `pool` for each device found by the last scan() and
+  // store it in `devices`, in address order. Devices for which the pool has no
+  // free driver of the right family are skipped. Returns the number of devices
+  // built.
+  uint8_t build(const I2CParallelPool& pool, I2CParallel** devices, const uint8_t maxDevices,
+      const uint32_t busSpeed = I2C_PARALLEL_MAX_BUS_SPEED);
+
+  // scan() followed by build().
+  uint8_t discover(const I2CParallelPool& pool, I2CParallel** devices, const uint8_t maxDevices,
+      const uint32_t busSpeed = I2C_PARALLEL_MAX_BUS_SPEED) {
+    scan(busSpeed);
+    return build(pool, devices, maxDevices, busSpeed);
+  };
+
+  // Total micros() spent in the last scan().
+  uint32_t getLastScanMicros() const { return _lastScanMicros; };
+
+private:
+  // Return true if `addr` ACKs a zero-length write.
+  bool probe(const uint8_t addr);
+  // Read one byte from `addr` without a command byte.
+  bool readByte(const uint8_t addr, uint8_t& val);
+  // Send command byte `reg` to `addr` and read one byte back after a repeated START.
+  bool readRegister(const uint8_t addr, const uint8_t reg, uint8_t& val);
+  // Tell a PCF8574 from a '9534 at a shared address.
+  uint8_t classify(const uint8_t addr);
+  void probeRange(const uint8_t minAddr, const uint8_t maxAddr, const bool shared);
+  // Apply `busSpeed` and `wireTimeout` to the controller.
+  void configureBus(const uint32_t busSpeed, const uint32_t wireTimeout);
+
+  TwoWire* _wire;
+  I2CParallelFound _found[I2C_PARALLEL_DISCOVERY_MAX_DEVICES];
+  uint8_t _numFound;
+  uint32_t _lastScanMicros;
+};
+
+#endif /* I2C_PARALLEL_DISCOVERY_H */
@@ -0,0 +1,256 @@
+// (c) Copyright 2026 Aaron Kimball
+// This library is licensed under the terms of the BSD 3-Clause license.
+// See the accompanying LICENSE.txt file for full license text.
+//
+// I2CParallelEvents Implementation
+//
+// To use, include I2CParallelEvents.h, construct an I2CParallelEvents around
+// an init()'ed device, call begin() with the MCU pin wired to INT_L, and call
+// service() from loop().
+
+#include <Arduino.h>
+#include <cstdint>
+
+#include "I2CParallelEvents.h"
+
+static constexpr uint8_t QUEUE_INDEX_MASK = I2C_PARALLEL_EVENT_QUEUE_LEN - 1;
+static_assert((I2C_PARALLEL_EVENT_QUEUE_LEN & QUEUE_INDEX_MASK) == 0,
+    "I2C_PARALLEL_EVENT_QUEUE_LEN must be a power of 2");
+
+static constexpr int8_t NO_ISR_SLOT = -1;
+
+// initInterrupt() takes a plain function pointer, so each instance that uses
+// begin() is bound to one of a fixed set of trampoline ISRs.
+static I2CParallelEvents* isrSlots[I2C_PARALLEL_MAX_EVENT_ISRS];
+
+template <uint8_t slot>
+static void slotIsr() {
+  if (isrSlots[slot] != nullptr) {
+    isrSlots[slot]->onInterrupt();
+  }
+}
+
+static void (*const slotIsrs[I2C_PARALLEL_MAX_EVENT_ISRS])() = {
+  slotIsr<0>,
+  slotIsr<1>,
+  slotIsr<2>,
+  slotIsr<3>,
+};
+
+static I2CParallelIntDispatcher* dispatchSlots[I2C_PARALLEL_MAX_DISPATCH_ISRS];
+
+template <uint8_t slot>
+static void dispatchIsr() {
+  if (dispatchSlots[slot] != nullptr) {
+    dispatchSlots[slot]->onInterrupt();
+  }
+}
+
+static void (*const dispatchIsrs[I2C_PARALLEL_MAX_DISPATCH_ISRS])() = {
+  dispatchIsr<0>,
+  dispatchIsr<1>,
+};
+
+I2CParallelEvents::I2CParallelEvents(I2CParallel& dev)
+    : _dev(dev), _pending(false), _intMicros(0), _watchMask(I2C_PARALLEL_MAX_VAL),
+      _lastInputs(dev.getLastInputState()), _intPin(INVALID_GPIO_PIN), _isrSlot(NO_ISR_SLOT), _head(0), _tail(0), _overflows(0) {
+  for (uint8_t i = 0; i <= I2C_MAX_BIT_POS; i++) {
+    _callbacks[i] = nullptr;
+    _contexts[i] = nullptr;
+  }
+}
+
+I2CParallelEvents::~I2CParallelEvents() {
+  if (_isrSlot != NO_ISR_SLOT) {
+    detachInterrupt(digitalPinToInterrupt(_intPin));
+    isrSlots[_isrSlot] = nullptr;
+  }
+}
+
+bool I2CParallelEvents::begin(const uint8_t digitalPinNum) {
+  if (_isrSlot == NO_ISR_SLOT) {
+    for (uint8_t i = 0; i < I2C_PARALLEL_MAX_EVENT_ISRS; i++) {
+      if (isrSlots[i] == nullptr) {
+        isrSlots[i] = this;
+        _isrSlot = i;
+        break;
+      }
+    }
+    if (_isrSlot == NO_ISR_SLOT) {
+      return false;
+    }
+  }
+
+  _intPin = digitalPinNum;
+  resetInputs();
+  _dev.initInterrupt(digitalPinNum, slotIsrs[_isrSlot]);
+  return true;
+}
+
+void I2CParallelEvents::onPinChange(
+    const uint8_t pin, I2CParallelPinCallback callback, void* context) {
+  if (pin > I2C_MAX_BIT_POS) {
+    return;
+  }
+  _callbacks[pin] = callback;
+  _contexts[pin] = context;
+}
+
+void I2CParallelEvents::pushEvent(const I2CParallelEvent& event) {
+  if (numEvents() >= I2C_PARALLEL_EVENT_QUEUE_LEN) {
+    _overflows++;
+    return;
+  }
+  _queue[_head & QUEUE_INDEX_MASK] = event;
+  _head++;
+}
+
+bool I2CParallelEvents::popEvent(I2CParallelEvent& event) {
+  if (_head == _tail) {
+    return false;
+  }
+  event = _queue[_tail & QUEUE_INDEX_MASK];
+  _tail++;
+  return true;
+}
+
+uint8_t I2CParallelEvents::service(const bool force) {
+  if (!_pending && !force) {
+    return 0;
+  }
+
+  // Clear the flag before reading, so an edge that arrives during the read is
+  // serviced next time rather than lost.
+  noInterrupts();
+  const uint32_t when = _pending ? _intMicros : micros();
+  _pending = false;
+  interrupts();
+
+  const uint8_t numEvents = serviceAt(when);
+
+  // The read cleared the device's interrupt. If INT_L is still low, another
+  // change happened after the read; its falling edge was consumed already.
+  if (_intPin != INVALID_GPIO_PIN && digitalRead(_intPin) == LOW) {
+    _pending = true;
+  }
+  return numEvents;
+}
+
+uint8_t I2CParallelEvents::serviceAt(const uint32_t when) {
+  // Compare against this object's own last read: any other getByte() on the
+  // device also updates its last known input state.
+  const uint8_t before = _lastInputs;
+  uint8_t nBytesRead = 0;
+  const uint8_t after = _dev.getByte(nBytesRead);
+  if (nBytesRead != 1) {
+    // Try again on the next service() call.
+    _pending = true;
+    return 0;
+  }
+  _lastInputs = after;
+
+  uint8_t numEvents = 0;
+  const uint8_t changed = (before ^ after) & _watchMask;
+  for (uint8_t pin = 0; changed != 0 && pin <= I2C_MAX_BIT_POS; pin++) {
+    const uint8_t bit = 1 << pin;
+    if ((changed & bit) == 0) {
+      continue;
+    }
+    const I2CParallelEvent event = { when, pin, (after & bit) != 0 };
+    if (_callbacks[pin] != nullptr) {
+      _callbacks[pin](event, _contexts[pin]);
+    } else {
+      pushEvent(event);
+    }
+    numEvents++;
+  }
+  return numEvents;
+}
+
+I2CParallelIntDispatcher::I2CParallelIntDispatcher(const uint8_t digitalPinNum)
+    : _numDevices(0), _intPin(digitalPinNum), _isrSlot(NO_ISR_SLOT), _lastReads(0),
+      _pending(false), _intMicros(0) {}
+
+I2CParallelIntDispatcher::~I2CParallelIntDispatcher() {
+  if (_isrSlot != NO_ISR_SLOT) {
+    detachInterrupt(digitalPinToInterrupt(_intPin));
+    dispatchSlots[_isrSlot] = nullptr;
+  }
+}
+
+bool I2CParallelIntDispatcher::add(I2CParallelEvents& events, const uint8_t priority) {
+  if (_numDevices == I2C_PARALLEL_DISPATCH_MAX_DEVICES) {
+    return false;
+  }
+  // Insert after every device of the same or higher priority (lower number).
+  uint8_t pos = _numDevices;
+  while (pos > 0 && _priorities[pos - 1] > priority) {
+    _devices[pos] = _devices[pos - 1];
+    _priorities[pos] = _priorities[pos - 1];
+    pos--;
+  }
+  _devices[pos] = &events;
+  _priorities[pos] = priority;
+  _numDevices++;
+
+  if (_isrSlot != NO_ISR_SLOT) {
+    events.device().initInterrupt(_intPin, dispatchIsrs[_isrSlot]);
+  }
+  return true;
+}
+
+bool I2CParallelIntDispatcher::begin() {
+  if (_isrSlot == NO_ISR_SLOT) {
+    for (uint8_t i = 0; i < I2C_PARALLEL_MAX_DISPATCH_ISRS; i++) {
+      if (dispatchSlots[i] == nullptr) {
+        dispatchSlots[i] = this;
+        _isrSlot = i;
+        break;
+      }
+    }
+    if (_isrSlot == NO_ISR_SLOT) {
+      return false;
+    }
+  }
+
+  // Each device attaches the same ISR; this also tells a '9534 that its INT_L
+  // is connected, for the interrupt errata workaround.
+  for (uint8_t i = 0; i < _numDevices; i++) {
+    _devices[i]->resetInputs();
+    _devices[i]->device().initInterrupt(_intPin, dispatchIsrs[_isrSlot]);
+  }
+  if (_numDevices == 0) {
+    pinMode(_intPin, INPUT_PULLUP);
+    attachInterrupt(digitalPinToInterrupt(_intPin), dispatchIsrs[_isrSlot], FALLING);
+  }
+  service(true);
+  return true;
+}
+
+uint8_t I2CParallelIntDispatcher::service(const bool force) {
+  _lastReads = 0;
+  if (!_pending && !force) {
+    return 0;
+  }
+
+  noInterrupts();
+  const uint32_t when = _pending ? _intMicros : micros();
+  _pending = false;
+  interrupts();
+
+  uint8_t numEvents = 0;
+  for (uint8_t i = 0; i < _numDevices; i++) {
+    if (!force && digitalRead(_intPin) == HIGH) {
+      break; // Every device holding the line low has been read.
+    }
+    numEvents += _devices[i]->serviceAt(when);
+    _lastReads++;
+  }
+
+  // A device that changed again after its read (or whose read failed) still
+  // holds the line low; its falling edge was consumed already.
+  if (digitalRead(_intPin) == LOW) {
+    _pending = true;
+  }
+  return numEvents;
+}
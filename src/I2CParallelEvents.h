@@ -0,0 +1,169 @@
+// (c) Copyright 2026 Aaron Kimball
+// This library is licensed under the terms of the BSD 3-Clause license.
+// See the accompanying LICENSE.txt file for full license text.
+//
+// Interrupt-driven input change events for I2C parallel bus expanders.
+
+#ifndef I2C_PARALLEL_EVENTS_H
+#define I2C_PARALLEL_EVENTS_H
+
+#include "I2CParallel2.h"
+
+// Capacity of each I2CParallelEvents queue. Must be a power of 2.
+static constexpr uint8_t I2C_PARALLEL_EVENT_QUEUE_LEN = 16;
+
+// Number of I2CParallelEvents instances that can use begin() to attach an ISR
+// at once. Others can call onInterrupt() from an ISR of their own.
+static constexpr uint8_t I2C_PARALLEL_MAX_EVENT_ISRS = 4;
+
+// Devices that can share one I2CParallelIntDispatcher.
+static constexpr uint8_t I2C_PARALLEL_DISPATCH_MAX_DEVICES = 16;
+
+// Number of I2CParallelIntDispatcher instances that can use begin() at once.
+static constexpr uint8_t I2C_PARALLEL_MAX_DISPATCH_ISRS = 2;
+
+/** A single input pin edge. */
+struct I2CParallelEvent {
+  uint32_t micros; // micros() when the INT_L interrupt fired.
+  uint8_t pin;     // Pin number (0--7) on the device.
+  bool rising;     // true for a 0->1 transition, false for 1->0.
+};
+
+// Called from service() for each edge on a pin with a registered callback.
+typedef void (*I2CParallelPinCallback)(const I2CParallelEvent& event, void* context);
+
+/**
+ * Turns INT_L interrupts from a device into per-pin edge events.
+ *
+ * The ISR only records that an interrupt is pending; it never touches Wire.
+ * Call service() from loop context: if an interrupt is pending it reads the
+ * device, diffs the result against the inputs it read last time, and produces
+ * one event per changed pin. Events for pins with a registered callback are
+ * delivered to that callback; the rest are queued for popEvent().
+ */
+class I2CParallelEvents {
+public:
+  explicit I2CParallelEvents(I2CParallel& dev);
+  ~I2CParallelEvents();
+
+  // Attach an internal ISR for the device's INT_L on `digitalPinNum` via
+  // dev.initInterrupt(). Returns false if all I2C_PARALLEL_MAX_EVENT_ISRS
+  // slots are in use; in that case call onInterrupt() from your own ISR.
+  bool begin(const uint8_t digitalPinNum);
+
+  // Record a pending interrupt. Safe to call from an ISR.
+  void onInterrupt() {
+    _intMicros = micros();
+    _pending = true;
+  };
+
+  // Return true if an interrupt is waiting to be serviced.
+  bool isPending() const { return _pending; };
+
+  // Take the device's last known input state as the state that later reads
+  // are compared against. begin() and I2CParallelIntDispatcher::begin() call
+  // this; reads made through the device itself do not affect it.
+  void resetInputs() { _lastInputs = _dev.getLastInputState(); };
+
+  // Only generate events for pins in `mask` (default: all pins).
+  void setWatchMask(const uint8_t mask) { _watchMask = mask; };
+
+  // Deliver events for `pin` to `callback` instead of the queue.
+  // Pass nullptr to go back to queueing them.
+  void onPinChange(const uint8_t pin, I2CParallelPinCallback callback, void* context = nullptr);
+
+  // Read and process the device inputs if an interrupt is pending (or always,
+  // if `force` is true). Returns the number of events generated.
+  uint8_t service(const bool force = false);
+
+  // Read and process the device inputs now, stamping events with `when`.
+  // Used by I2CParallelIntDispatcher, which tracks the interrupt itself.
+  uint8_t serviceAt(const uint32_t when);
+
+  I2CParallel& device() const { return _dev; };
+
+  // Remove the oldest queued event into `event`. Returns false if none.
+  bool popEvent(I2CParallelEvent& event);
+  uint8_t numEvents() const { return (uint8_t)(_head - _tail); };
+
+  // Number of events dropped because the queue was full.
+  uint16_t getOverflowCount() const { return _overflows; };
+
+private:
+  void pushEvent(const I2CParallelEvent& event);
+
+  I2CParallel& _dev;
+  volatile bool _pending;
+  volatile uint32_t _intMicros;
+  uint8_t _watchMask;
+  uint8_t _lastInputs; // Input state as of the last read made by serviceAt().
+  uint8_t _intPin;
+  int8_t _isrSlot;
+
+  I2CParallelPinCallback _callbacks[I2C_MAX_BIT_POS + 1];
+  void* _contexts[I2C_MAX_BIT_POS + 1];
+
+  I2CParallelEvent _queue[I2C_PARALLEL_EVENT_QUEUE_LEN];
+  uint8_t _head; // Free-running write index.
+  uint8_t _tail; // Free-running read index.
+  uint16_t _overflows;
+};
+
+/**
+ * Services several devices whose open-drain INT_L outputs share one MCU pin.
+ *
+ * Each device is registered through its own I2CParallelEvents, which keeps
+ * its per-pin callbacks and event queue. On an interrupt, service() reads the
+ * devices in ascending priority order and stops as soon as the line is high
+ * again: once every device that pulled it low has been read, the rest are not
+ * touched. Give the devices whose inputs change most often the lowest
+ * priority numbers to keep the reads per interrupt down.
+ */
+class I2CParallelIntDispatcher {
+public:
+  explicit I2CParallelIntDispatcher(const uint8_t digitalPinNum);
+  ~I2CParallelIntDispatcher();
+
+  // Register a device on this line. Devices are serviced in ascending
+  // `priority` order; equal priorities in the order added. Returns false if
+  // I2C_PARALLEL_DISPATCH_MAX_DEVICES are already registered.
+  bool add(I2CParallelEvents& events, const uint8_t priority = 0);
+
+  // Attach an internal ISR to the pin, mark every registered device as having
+  // its INT_L connected there, and read each device once so that its INT_L is
+  // armed (see I2CParallel9534::setIntPinMode()). Returns false if all
+  // I2C_PARALLEL_MAX_DISPATCH_ISRS slots are in use; in that case call
+  // onInterrupt() from your own ISR.
+  bool begin();
+
+  // Record a pending interrupt. Safe to call from an ISR.
+  void onInterrupt() {
+    _intMicros = micros();
+    _pending = true;
+  };
+
+  // Return true if an interrupt is waiting to be serviced.
+  bool isPending() const { return _pending; };
+
+  uint8_t size() const { return _numDevices; };
+
+  // If an interrupt is pending, read devices in priority order until the line
+  // is released. With `force`, read every device regardless. Returns the
+  // number of events generated.
+  uint8_t service(const bool force = false);
+
+  // Devices read by the last service() call.
+  uint8_t getLastReadCount() const { return _lastReads; };
+
+private:
+  I2CParallelEvents* _devices[I2C_PARALLEL_DISPATCH_MAX_DEVICES];
+  uint8_t _priorities[I2C_PARALLEL_DISPATCH_MAX_DEVICES];
+  uint8_t _numDevices;
+  uint8_t _intPin;
+  int8_t _isrSlot;
+  uint8_t _lastReads;
+  volatile bool _pending;
+  volatile uint32_t _intMicros;
+};
+
+#endif /* I2C_PARALLEL_EVENTS_H */
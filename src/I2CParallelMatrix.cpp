@@ -0,0 +1,102 @@
+// (c) Copyright 2026 Aaron Kimball
+// This library is licensed under the terms of the BSD 3-Clause license.
+// See the accompanying LICENSE.txt file for full license text.
+//
+// I2CParallelMatrix Implementation
+//
+// To use, include I2CParallelMatrix.h, construct an I2CParallelMatrix over an
+// init()'ed device, call begin() once and scan() periodically.
+
+#include <Arduino.h>
+#include <cstdint>
+
+#include "I2CParallelMatrix.h"
+
+I2CParallelMatrix::I2CParallelMatrix(I2CParallel& dev, const uint8_t rowMask, const uint8_t colMask)
+    : _dev(dev), _rowMask(0), _colMask(colMask & ~rowMask), _numRows(0), _numCols(0),
+      _diodes(false), _ghosted(false) {
+  for (uint8_t pin = 0; pin <= I2C_MAX_BIT_POS; pin++) {
+    const uint8_t bit = 1 << pin;
+    if ((rowMask & bit) != 0 && _numRows < I2C_PARALLEL_MATRIX_MAX_ROWS) {
+      _rowMask |= bit;
+      _rowMasks[_numRows] = bit;
+      _keys[_numRows] = 0;
+      _pressed[_numRows] = 0;
+      _released[_numRows] = 0;
+      _numRows++;
+    } else if ((_colMask & bit) != 0) {
+      _numCols++;
+    }
+  }
+}
+
+void I2CParallelMatrix::begin() {
+  _dev.enableInputs(_rowMask | _colMask);
+}
+
+uint8_t I2CParallelMatrix::packColumns(const uint8_t pins) const {
+  uint8_t cols = 0;
+  uint8_t col = 0;
+  for (uint8_t pin = 0; pin <= I2C_MAX_BIT_POS; pin++) {
+    const uint8_t bit = 1 << pin;
+    if ((_colMask & bit) == 0) {
+      continue;
+    }
+    if ((pins & bit) != 0) {
+      cols |= 1 << col;
+    }
+    col++;
+  }
+  return cols;
+}
+
+bool I2CParallelMatrix::scan() {
+  uint8_t sense[I2C_PARALLEL_MATRIX_MAX_ROWS];
+  if (_dev.scanRows(_rowMasks, _numRows, sense) != _numRows) {
+    return false;
+  }
+
+  uint8_t keys[I2C_PARALLEL_MATRIX_MAX_ROWS];
+  for (uint8_t r = 0; r < _numRows; r++) {
+    keys[r] = packColumns(~sense[r]);
+  }
+
+  // Two rows sharing two or more pressed columns form a rectangle: any of its
+  // corners may be a ghost of the other three.
+  _ghosted = false;
+  for (uint8_t r = 0; r < _numRows && !_diodes && !_ghosted; r++) {
+    for (uint8_t s = r + 1; s < _numRows; s++) {
+      const uint8_t shared = keys[r] & keys[s];
+      if ((shared & (shared - 1)) != 0) {
+        _ghosted = true;
+        break;
+      }
+    }
+  }
+
+  for (uint8_t r = 0; r < _numRows; r++) {
+    // While ghosted, only accept releases.
+    const uint8_t next = _ghosted ? keys[r] & _keys[r] : keys[r];
+    _pressed[r] = next & ~_keys[r];
+    _released[r] = _keys[r] & ~next;
+    _keys[r] = next;
+  }
+  return true;
+}
+
+bool I2CParallelMatrix::isPressed(const uint8_t row, const uint8_t col) const {
+  if (row >= _numRows || col >= _numCols) {
+    return false;
+  }
+  return (_keys[row] >> col) & 1;
+}
+
+uint8_t I2CParallelMatrix::numPressed() const {
+  uint8_t count = 0;
+  for (uint8_t r = 0; r < _numRows; r++) {
+    for (uint8_t keys = _keys[r]; keys != 0; keys &= keys - 1) {
+      count++;
+    }
+  }
+  return count;
+}
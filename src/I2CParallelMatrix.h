@@ -0,0 +1,84 @@
+// (c) Copyright 2026 Aaron Kimball
+// This library is licensed under the terms of the BSD 3-Clause license.
+// See the accompanying LICENSE.txt file for full license text.
+//
+// Key matrix scanning over a single I2C parallel bus expander.
+
+#ifndef I2C_PARALLEL_MATRIX_H
+#define I2C_PARALLEL_MATRIX_H
+
+#include "I2CParallel2.h"
+
+// Rows and columns share the device's 8 pins; at least one pin is a column.
+static constexpr uint8_t I2C_PARALLEL_MATRIX_MAX_ROWS = 7;
+
+/**
+ * Scans a key matrix whose rows and columns are wired to one device.
+ *
+ * Rows are the pins in `rowMask`, columns the pins in `colMask`; row `r` is
+ * the r'th lowest pin of `rowMask`, and likewise for columns. A pressed key
+ * connects its row to its column, so it reads low while its row is pulled
+ * low. scan() reads the whole matrix with I2CParallel::scanRows(), in a
+ * single I2C transaction with a repeated START between each row write and read.
+ *
+ * Without diodes, three keys pressed at the corners of a rectangle make the
+ * fourth read as pressed too ("ghosting"). Unless setDiodes(true) is called,
+ * scan() detects matrices where that is possible and then reports no new
+ * presses (releases still count) until the ambiguity clears, so any set of
+ * keys that can be told apart is reported (n-key rollover). With a diode per
+ * key every combination is unambiguous.
+ *
+ * A full scan of a 4x4 matrix takes about 0.4 ms ('8574) or 0.7 ms ('9534) of
+ * bus time at 400 kHz, so it can be scanned every millisecond or two and the
+ * rows fed to an I2CParallelDebounce (one lane per row) with a short depth.
+ */
+class I2CParallelMatrix {
+public:
+  I2CParallelMatrix(I2CParallel& dev, const uint8_t rowMask, const uint8_t colMask);
+  ~I2CParallelMatrix(){};
+
+  // Make the row and column pins inputs. On a '9534 this is a CONFIG write,
+  // so the device's other pins become outputs.
+  void begin();
+
+  // Scan every row. Returns false (and leaves the key state unchanged) if the
+  // device could not be read.
+  bool scan();
+
+  uint8_t numRows() const { return _numRows; };
+  uint8_t numCols() const { return _numCols; };
+
+  // Set true if the matrix has a diode on every key: disables ghost blocking.
+  void setDiodes(const bool diodes) { _diodes = diodes; };
+
+  // Pressed keys of a row, as a mask of column numbers (bit c = column c).
+  uint8_t getRow(const uint8_t row) const { return row < _numRows ? _keys[row] : 0; };
+  bool isPressed(const uint8_t row, const uint8_t col) const;
+  // Number of keys currently pressed.
+  uint8_t numPressed() const;
+
+  // Keys of a row newly pressed / released by the last scan(), by column.
+  uint8_t getPressed(const uint8_t row) const { return row < _numRows ? _pressed[row] : 0; };
+  uint8_t getReleased(const uint8_t row) const { return row < _numRows ? _released[row] : 0; };
+
+  // Return true if the last scan() saw a ghosting pattern.
+  bool isGhosted() const { return _ghosted; };
+
+private:
+  // Map the device's column pins to consecutive column numbers.
+  uint8_t packColumns(const uint8_t pins) const;
+
+  I2CParallel& _dev;
+  uint8_t _rowMasks[I2C_PARALLEL_MATRIX_MAX_ROWS]; // Device pin mask of each row.
+  uint8_t _keys[I2C_PARALLEL_MATRIX_MAX_ROWS];
+  uint8_t _pressed[I2C_PARALLEL_MATRIX_MAX_ROWS];
+  uint8_t _released[I2C_PARALLEL_MATRIX_MAX_ROWS];
+  uint8_t _rowMask;
+  uint8_t _colMask;
+  uint8_t _numRows;
+  uint8_t _numCols;
+  bool _diodes;
+  bool _ghosted;
+};
+
+#endif /* I2C_PARALLEL_MATRIX_H */
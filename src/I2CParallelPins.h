@@ -0,0 +1,258 @@
+// (c) Copyright 2026 Aaron Kimball
+// This library is licensed under the terms of the BSD 3-Clause license.
+// See the accompanying LICENSE.txt file for full license text.
+//
+// Compile-time logical pin maps for I2C parallel bus expanders.
+//
+// Name the pins (and multi-pin fields) of one or more devices once, as types:
+//
+//   typedef I2CParallelPin<0, 3> LedRed;        // Device 0, bit 3.
+//   typedef I2CParallelPin<0, 5> LedGreen;      // Device 0, bit 5.
+//   typedef I2CParallelField<0, 4, 8> Segments; // Device 0 bits 4-7, device 1 bits 0-3.
+//
+//   I2CParallelPinMap<2> pins(dev0, dev1);
+//   pins.set<LedRed, LedGreen>();
+//   pins.write<Segments>(0xA5);
+//
+// Every mask is a constant, so each operation compiles to one setByte() per
+// device it touches (no mask arithmetic at runtime, devices it does not touch
+// are skipped). Pin operations bypass beginUpdate() / commit() batching.
+
+#ifndef I2C_PARALLEL_PINS_H
+#define I2C_PARALLEL_PINS_H
+
+#include "I2CParallel2.h"
+
+/**
+ * `Width` consecutive pins starting at bit `FirstBit` of device `Device`.
+ * Pins are numbered across the devices of a map as in I2CParallelBank (pin p
+ * is bit p % 8 of device p / 8), so a field may continue onto the following
+ * devices. Bit 0 of a field value is its lowest pin.
+ */
+template <uint8_t Device, uint8_t FirstBit, uint8_t Width = 1>
+struct I2CParallelField {
+  static_assert(FirstBit <= I2C_MAX_BIT_POS, "FirstBit must be 0--7");
+  static_assert(Width >= 1 && Width <= 32, "A field is 1 to 32 pins wide");
+
+  static constexpr uint16_t FIRST_PIN = Device * 8 + FirstBit;
+  static constexpr uint16_t LAST_PIN = FIRST_PIN + Width - 1;
+  static constexpr uint8_t FIRST_DEVICE = Device;
+  static constexpr uint8_t LAST_DEVICE = LAST_PIN / 8;
+  static constexpr uint8_t WIDTH = Width;
+
+  // The field's bits on device `dev`, or 0 if it has none there.
+  static constexpr uint8_t maskOn(const uint8_t dev) {
+    return (dev < FIRST_DEVICE || dev > LAST_DEVICE)
+        ? 0
+        : (uint8_t)(lowBits(LAST_PIN >= dev * 8 + 7 ? 8 : LAST_PIN - dev * 8 + 1)
+              & ~lowBits(FIRST_PIN <= dev * 8 ? 0 : FIRST_PIN - dev * 8));
+  };
+
+  // The bits of `value` that land on device `dev`, in place.
+  static constexpr uint8_t toDevice(const uint8_t dev, const uint32_t value) {
+    return (uint8_t)(shiftOn(dev) >= 0 ? value << shiftOn(dev) : value >> -shiftOn(dev))
+        & maskOn(dev);
+  };
+
+  // The field bits held in byte `val` of device `dev`, as part of a field value.
+  static constexpr uint32_t fromDevice(const uint8_t dev, const uint8_t val) {
+    return shiftOn(dev) >= 0 ? (uint32_t)(val & maskOn(dev)) >> shiftOn(dev)
+                             : (uint32_t)(val & maskOn(dev)) << -shiftOn(dev);
+  };
+
+private:
+  // Bit of device `dev` that holds bit 0 of the field (negative if it is on an
+  // earlier device).
+  static constexpr int shiftOn(const uint8_t dev) { return (int)FIRST_PIN - dev * 8; };
+  static constexpr uint16_t lowBits(const uint8_t n) { return (uint16_t)((1U << n) - 1); };
+};
+
+/** A single named pin: bit `Bit` of device `Device`. */
+template <uint8_t Device, uint8_t Bit>
+using I2CParallelPin = I2CParallelField<Device, Bit>;
+
+/** The union of the bits of `Fields` on device `Dev`. */
+template <uint8_t Dev, typename... Fields>
+struct I2CParallelMaskOn;
+
+template <uint8_t Dev>
+struct I2CParallelMaskOn<Dev> {
+  static constexpr uint8_t VALUE = 0;
+  static constexpr uint8_t LAST_DEVICE = 0;
+};
+
+template <uint8_t Dev, typename Field, typename... Rest>
+struct I2CParallelMaskOn<Dev, Field, Rest...> {
+  static constexpr uint8_t VALUE = Field::maskOn(Dev) | I2CParallelMaskOn<Dev, Rest...>::VALUE;
+  // Highest device index any of the fields reaches.
+  static constexpr uint8_t LAST_DEVICE =
+      Field::LAST_DEVICE > I2CParallelMaskOn<Dev, Rest...>::LAST_DEVICE
+      ? Field::LAST_DEVICE
+      : I2CParallelMaskOn<Dev, Rest...>::LAST_DEVICE;
+};
+
+// Operations of I2CParallelPinWalk::update().
+static constexpr uint8_t I2C_PARALLEL_PINS_SET = 0;
+static constexpr uint8_t I2C_PARALLEL_PINS_CLR = 1;
+static constexpr uint8_t I2C_PARALLEL_PINS_TOGGLE = 2;
+
+/**
+ * One device's share of a pin operation: write ((state & ~Clear) | set) ^ Flip
+ * with a single setByte(). The specializations drop the read of the output
+ * state when every bit is replaced, and the write when no bit is affected.
+ */
+template <uint8_t Clear, uint8_t Flip>
+struct I2CParallelPinApply {
+  template <typename DevT>
+  static size_t apply(DevT& dev, const uint8_t set) {
+    return dev.setByte((uint8_t)(((dev.getLastOutputState() & ~Clear) | set) ^ Flip));
+  };
+};
+
+template <uint8_t Flip>
+struct I2CParallelPinApply<0xFF, Flip> {
+  template <typename DevT>
+  static size_t apply(DevT& dev, const uint8_t set) {
+    return dev.setByte(set ^ Flip);
+  };
+};
+
+template <>
+struct I2CParallelPinApply<0, 0> {
+  template <typename DevT>
+  static size_t apply(DevT& dev, const uint8_t set) {
+    return 0;
+  };
+};
+
+/**
+ * Walks devices `Dev` to `End` - 1 at compile time, giving each device that
+ * has bits in the operation a single setByte().
+ */
+template <uint8_t Dev, uint8_t End>
+struct I2CParallelPinWalk {
+  // Apply I2C_PARALLEL_PINS_<Op> to the bits of `Fields`.
+  template <uint8_t Op, typename DevT, typename... Fields>
+  static size_t update(DevT* const* devs) {
+    static constexpr uint8_t MASK = I2CParallelMaskOn<Dev, Fields...>::VALUE;
+    static constexpr uint8_t CLEAR = Op == I2C_PARALLEL_PINS_TOGGLE ? 0 : MASK;
+    static constexpr uint8_t FLIP = Op == I2C_PARALLEL_PINS_TOGGLE ? MASK : 0;
+    return I2CParallelPinApply<CLEAR, FLIP>::apply(
+               *devs[Dev], Op == I2C_PARALLEL_PINS_SET ? MASK : 0)
+        + I2CParallelPinWalk<Dev + 1, End>::template update<Op, DevT, Fields...>(devs);
+  };
+
+  template <typename Field, typename DevT>
+  static size_t write(DevT* const* devs, const uint32_t value) {
+    return I2CParallelPinApply<Field::maskOn(Dev), 0>::apply(
+               *devs[Dev], Field::toDevice(Dev, value))
+        + I2CParallelPinWalk<Dev + 1, End>::template write<Field, DevT>(devs, value);
+  };
+
+  template <typename Field, typename DevT>
+  static bool read(DevT* const* devs, uint32_t& value) {
+    uint8_t nBytesRead = 0;
+    const uint8_t val = devs[Dev]->getByte(nBytesRead);
+    value |= Field::fromDevice(Dev, val);
+    return nBytesRead == 1
+        && I2CParallelPinWalk<Dev + 1, End>::template read<Field, DevT>(devs, value);
+  };
+
+  template <typename Field, typename DevT>
+  static uint32_t outputs(DevT* const* devs) {
+    return Field::fromDevice(Dev, devs[Dev]->getLastOutputState())
+        | I2CParallelPinWalk<Dev + 1, End>::template outputs<Field, DevT>(devs);
+  };
+};
+
+template <uint8_t End>
+struct I2CParallelPinWalk<End, End> {
+  template <uint8_t Op, typename DevT, typename... Fields>
+  static size_t update(DevT* const* devs) {
+    return 0;
+  };
+  template <typename Field, typename DevT>
+  static size_t write(DevT* const* devs, const uint32_t value) {
+    return 0;
+  };
+  template <typename Field, typename DevT>
+  static bool read(DevT* const* devs, uint32_t& value) {
+    return true;
+  };
+  template <typename Field, typename DevT>
+  static uint32_t outputs(DevT* const* devs) {
+    return 0;
+  };
+};
+
+/**
+ * The `NumDevices` devices that a set of I2CParallelField / I2CParallelPin
+ * types refer to, in device-index order. `Dev` is I2CParallel by default; use
+ * an I2CParallelT type to map pins of compile-time drivers.
+ *
+ * Each device must be init()'ed by the caller. set(), clr(), toggle() and
+ * write() return the number of devices written successfully. Naming a pin
+ * beyond the last device fails to compile.
+ */
+template <uint8_t NumDevices, typename Dev = I2CParallel>
+class I2CParallelPinMap {
+public:
+  template <typename... Devs>
+  explicit I2CParallelPinMap(Devs&... devs) : _devices{ &devs... } {
+    static_assert(sizeof...(Devs) == NumDevices, "Pass one device per map index");
+  };
+
+  // Drive every pin of `Fields` high / low, or toggle them.
+  template <typename... Fields>
+  size_t set() {
+    return update<I2C_PARALLEL_PINS_SET, Fields...>();
+  };
+  template <typename... Fields>
+  size_t clr() {
+    return update<I2C_PARALLEL_PINS_CLR, Fields...>();
+  };
+  template <typename... Fields>
+  size_t toggle() {
+    return update<I2C_PARALLEL_PINS_TOGGLE, Fields...>();
+  };
+
+  // Set the pins of `Field` to the low `Field::WIDTH` bits of `value`.
+  template <typename Field>
+  size_t write(const uint32_t value) {
+    static_assert(Field::LAST_DEVICE < NumDevices, "Field is beyond the last device");
+    return I2CParallelPinWalk<Field::FIRST_DEVICE, Field::LAST_DEVICE + 1>::template write<Field>(
+        _devices, value);
+  };
+
+  // The value last written to the pins of `Field` (no bus I/O).
+  template <typename Field>
+  uint32_t get() const {
+    static_assert(Field::LAST_DEVICE < NumDevices, "Field is beyond the last device");
+    return I2CParallelPinWalk<Field::FIRST_DEVICE, Field::LAST_DEVICE + 1>::template outputs<Field>(
+        _devices);
+  };
+
+  // Read the input state of the pins of `Field` into `value`. Returns false if
+  // a device could not be read.
+  template <typename Field>
+  bool read(uint32_t& value) {
+    static_assert(Field::LAST_DEVICE < NumDevices, "Field is beyond the last device");
+    value = 0;
+    return I2CParallelPinWalk<Field::FIRST_DEVICE, Field::LAST_DEVICE + 1>::template read<Field>(
+        _devices, value);
+  };
+
+  Dev& device(const uint8_t idx) const { return *_devices[idx]; };
+
+private:
+  template <uint8_t Op, typename... Fields>
+  size_t update() {
+    static_assert(I2CParallelMaskOn<0, Fields...>::LAST_DEVICE < NumDevices,
+        "Pin is beyond the last device");
+    return I2CParallelPinWalk<0, NumDevices>::template update<Op, Dev, Fields...>(_devices);
+  };
+
+  Dev* _devices[NumDevices];
+};
+
+#endif /* I2C_PARALLEL_PINS_H */
@@ -0,0 +1,97 @@
+// (c) Copyright 2026 Aaron Kimball
+// This library is licensed under the terms of the BSD 3-Clause license.
+// See the accompanying LICENSE.txt file for full license text.
+//
+// I2CParallelScheduler Implementation
+//
+// To use, include I2CParallelScheduler.h, init() each device at its own
+// maximum bus speed, add() an I2CParallelAsync queue per device, and call
+// run() from loop() instead of each queue's poll().
+
+#include <Arduino.h>
+#include <cstdint>
+
+#include "I2CParallelScheduler.h"
+
+I2CParallelScheduler::I2CParallelScheduler(TwoWire& wire)
+    : _wire(&wire), _numQueues(0), _numSpeeds(0), _clock(0), _clockSwitches(0) {
+  resetStats();
+}
+
+bool I2CParallelScheduler::add(I2CParallelAsync& queue) {
+  if (_numQueues == I2C_PARALLEL_SCHEDULER_MAX_QUEUES) {
+    return false;
+  }
+  const uint32_t busSpeed = queue.device().getBusSpeed();
+  uint8_t speedIdx = 0;
+  while (speedIdx < _numSpeeds && _speeds[speedIdx] != busSpeed) {
+    speedIdx++;
+  }
+  if (speedIdx == _numSpeeds) {
+    if (_numSpeeds == I2C_PARALLEL_SCHEDULER_MAX_SPEEDS) {
+      return false;
+    }
+    _speeds[_numSpeeds++] = busSpeed;
+  }
+  _queues[_numQueues] = &queue;
+  _queueSpeed[_numQueues] = speedIdx;
+  _numQueues++;
+  return true;
+}
+
+void I2CParallelScheduler::resetStats() {
+  for (uint8_t i = 0; i < I2C_PARALLEL_SCHEDULER_MAX_SPEEDS; i++) {
+    _micros[i] = 0;
+    _ops[i] = 0;
+  }
+  _clockSwitches = 0;
+}
+
+void I2CParallelScheduler::setSpeed(const uint32_t busSpeed) {
+  if (busSpeed != _clock) {
+    _wire->setClock(busSpeed);
+    _clock = busSpeed;
+    _clockSwitches++;
+  }
+}
+
+bool I2CParallelScheduler::hasPending(const uint8_t speedIdx) const {
+  for (uint8_t i = 0; i < _numQueues; i++) {
+    if (_queueSpeed[i] == speedIdx && !_queues[i]->isEmpty()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+int8_t I2CParallelScheduler::nextSpeed() const {
+  int8_t best = -1;
+  for (uint8_t s = 0; s < _numSpeeds; s++) {
+    if (!hasPending(s)) {
+      continue;
+    } else if (_speeds[s] == _clock) {
+      return s; // No clock switch needed.
+    } else if (best < 0 || _speeds[s] > _speeds[best]) {
+      best = s;
+    }
+  }
+  return best;
+}
+
+uint16_t I2CParallelScheduler::run() {
+  uint16_t numPerformed = 0;
+  for (int8_t s = nextSpeed(); s >= 0; s = nextSpeed()) {
+    setSpeed(_speeds[s]);
+    const uint32_t start = micros();
+    uint16_t numAtSpeed = 0;
+    for (uint8_t i = 0; i < _numQueues; i++) {
+      if (_queueSpeed[i] == s) {
+        numAtSpeed += _queues[i]->flush();
+      }
+    }
+    _micros[s] += micros() - start;
+    _ops[s] += numAtSpeed;
+    numPerformed += numAtSpeed;
+  }
+  return numPerformed;
+}
@@ -0,0 +1,88 @@
+// (c) Copyright 2026 Aaron Kimball
+// This library is licensed under the terms of the BSD 3-Clause license.
+// See the accompanying LICENSE.txt file for full license text.
+//
+// Running devices with different maximum clock rates on one I2C bus.
+
+#ifndef I2C_PARALLEL_SCHEDULER_H
+#define I2C_PARALLEL_SCHEDULER_H
+
+#include "I2CParallel2.h"
+#include "I2CParallelAsync.h"
+
+// Operation queues that can be registered with one I2CParallelScheduler.
+static constexpr uint8_t I2C_PARALLEL_SCHEDULER_MAX_QUEUES = 16;
+
+// Distinct bus speeds one I2CParallelScheduler keeps apart.
+static constexpr uint8_t I2C_PARALLEL_SCHEDULER_MAX_SPEEDS = 4;
+
+/**
+ * Services the I2CParallelAsync queues of devices that share one I2C bus but
+ * not one maximum clock rate (e.g. a 100 kHz PCF8574 next to 400 kHz
+ * PCA9534s).
+ *
+ * Each queue's speed class is the bus speed its device was init()'ed with.
+ * run() performs the pending operations grouped by speed class: first those
+ * of the class the bus is already clocked at, then the remaining classes,
+ * fastest first. Wire.setClock() is only called when the class changes. Each
+ * queue's own operations keep their order; operations on different devices
+ * may be reordered.
+ *
+ * Every transfer on the bus must then go through the scheduler: queue it, or
+ * call select() before direct I/O on a device. Call invalidateClock() if
+ * anything else (such as a device init()) calls setClock().
+ */
+class I2CParallelScheduler {
+public:
+  explicit I2CParallelScheduler(TwoWire& wire = Wire);
+  ~I2CParallelScheduler(){};
+
+  // Register a queue. Returns false if the queue table is full, or the
+  // device's speed would be one more than I2C_PARALLEL_SCHEDULER_MAX_SPEEDS.
+  bool add(I2CParallelAsync& queue);
+  uint8_t size() const { return _numQueues; };
+
+  // Perform every pending operation (including any queued by read callbacks
+  // during the run), grouped by speed. Returns the number performed.
+  uint16_t run();
+
+  // Clock the bus for direct I/O on `dev`.
+  void select(const I2CParallel& dev) { setSpeed(dev.getBusSpeed()); };
+
+  // Forget the bus clock rate, so the next transfer sets it.
+  void invalidateClock() { _clock = 0; };
+
+  // Number of setClock() calls made.
+  uint32_t getClockSwitches() const { return _clockSwitches; };
+
+  // Speed classes seen by add(), in the order they were first seen, and the
+  // micros() spent performing operations (and number performed) at each.
+  uint8_t numSpeeds() const { return _numSpeeds; };
+  uint32_t getSpeed(const uint8_t idx) const { return idx < _numSpeeds ? _speeds[idx] : 0; };
+  uint32_t getMicrosAt(const uint8_t idx) const { return idx < _numSpeeds ? _micros[idx] : 0; };
+  uint32_t getOpsAt(const uint8_t idx) const { return idx < _numSpeeds ? _ops[idx] : 0; };
+
+  // Zero the clock switch, time and operation counters.
+  void resetStats();
+
+private:
+  // Speed class to service next, or -1 if no queue has pending operations.
+  int8_t nextSpeed() const;
+  bool hasPending(const uint8_t speedIdx) const;
+  void setSpeed(const uint32_t busSpeed);
+
+  TwoWire* _wire;
+  I2CParallelAsync* _queues[I2C_PARALLEL_SCHEDULER_MAX_QUEUES];
+  uint8_t _queueSpeed[I2C_PARALLEL_SCHEDULER_MAX_QUEUES]; // Index into _speeds.
+  uint8_t _numQueues;
+
+  uint32_t _speeds[I2C_PARALLEL_SCHEDULER_MAX_SPEEDS];
+  uint32_t _micros[I2C_PARALLEL_SCHEDULER_MAX_SPEEDS];
+  uint32_t _ops[I2C_PARALLEL_SCHEDULER_MAX_SPEEDS];
+  uint8_t _numSpeeds;
+
+  uint32_t _clock; // Rate last given to setClock(), or 0 if unknown.
+  uint32_t _clockSwitches;
+};
+
+#endif /* I2C_PARALLEL_SCHEDULER_H */
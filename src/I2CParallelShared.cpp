@@ -0,0 +1,150 @@
+// (c) Copyright 2026 Aaron Kimball
+// This library is licensed under the terms of the BSD 3-Clause license.
+// See the accompanying LICENSE.txt file for full license text.
+//
+// I2CParallelShared Implementation
+//
+// To use, include I2CParallelShared.h, create one I2CParallelBusLock per I2C
+// controller, and wrap each init()'ed device in an I2CParallelShared.
+
+#include <Arduino.h>
+#include <cstdint>
+
+#include "I2CParallelShared.h"
+
+void I2CParallelBusLock::lock() {
+  while (!tryLock()) {
+    yield();
+  }
+}
+
+uint32_t I2CParallelBusLock::getWriteCount() {
+  // The count is wider than the bus can load or store atomically.
+  lock();
+  const uint32_t writes = _writes;
+  unlock();
+  return writes;
+}
+
+bool I2CParallelBusLock::add(I2CParallelShared* dev) {
+  if (_numDevices == I2C_PARALLEL_SHARED_MAX_DEVICES) {
+    return false;
+  }
+  _devices[_numDevices++] = dev;
+  return true;
+}
+
+bool I2CParallelBusLock::writePending() {
+  bool ok = true;
+  for (uint8_t i = 0; i < _numDevices; i++) {
+    ok &= _devices[i]->writePending();
+  }
+  return ok;
+}
+
+bool I2CParallelBusLock::anyPending() const {
+  for (uint8_t i = 0; i < _numDevices; i++) {
+    if (_devices[i]->isPending()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+I2CParallelShared::I2CParallelShared(I2CParallel& dev, I2CParallelBusLock& lock)
+    : _dev(dev), _lock(lock), _target(dev.getLastOutputState()),
+      _written(dev.getLastOutputState()) {
+  // Register before any other context can use the device.
+  _lock.add(this);
+}
+
+void I2CParallelShared::postOr(const uint8_t val) {
+  uint8_t cur = _target.load();
+  while (!_target.compareExchangeWeak(cur, cur | val)) {
+  }
+}
+
+void I2CParallelShared::postAnd(const uint8_t val) {
+  uint8_t cur = _target.load();
+  while (!_target.compareExchangeWeak(cur, cur & val)) {
+  }
+}
+
+void I2CParallelShared::postXor(const uint8_t val) {
+  uint8_t cur = _target.load();
+  while (!_target.compareExchangeWeak(cur, cur ^ val)) {
+  }
+}
+
+bool I2CParallelShared::writePending() {
+  const uint8_t val = _target.load();
+  if (val == _written.load()) {
+    return true;
+  } else if (_dev.setByte(val) != 1) {
+    return false;
+  }
+  _written.store(val);
+  _lock._writes++;
+  return true;
+}
+
+bool I2CParallelShared::flush() {
+  for (;;) {
+    if (!_lock.tryLock()) {
+      return false; // The owner writes our target before it releases the bus.
+    }
+    const bool ok = _lock.writePending();
+    _lock.unlock();
+    if (!ok) {
+      return false; // The failed write stays pending for the next call.
+    }
+    // A context that posted after its device was written, but before the
+    // unlock, found the bus busy and left its update to us.
+    if (!_lock.anyPending()) {
+      return true;
+    }
+  }
+}
+
+bool I2CParallelShared::setByte(const uint8_t val) {
+  postByte(val);
+  return flush();
+}
+
+bool I2CParallelShared::setOr(const uint8_t val) {
+  postOr(val);
+  return flush();
+}
+
+bool I2CParallelShared::setAnd(const uint8_t val) {
+  postAnd(val);
+  return flush();
+}
+
+bool I2CParallelShared::setXor(const uint8_t val) {
+  postXor(val);
+  return flush();
+}
+
+bool I2CParallelShared::setBit(const uint8_t bitPos) {
+  return bitPos <= I2C_MAX_BIT_POS && setOr((uint8_t)(1 << bitPos));
+}
+
+bool I2CParallelShared::clrBit(const uint8_t bitPos) {
+  return bitPos <= I2C_MAX_BIT_POS && setAnd((uint8_t) ~(1 << bitPos));
+}
+
+bool I2CParallelShared::toggleBit(const uint8_t bitPos) {
+  return bitPos <= I2C_MAX_BIT_POS && setXor((uint8_t)(1 << bitPos));
+}
+
+uint8_t I2CParallelShared::getByte(uint8_t& nBytesRead) {
+  _lock.lock();
+  _lock.writePending();
+  const uint8_t val = _dev.getByte(nBytesRead);
+  _lock.unlock();
+  if (_lock.anyPending()) {
+    flush();
+  }
+  return val;
+}
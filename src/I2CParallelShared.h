@@ -0,0 +1,192 @@
+// (c) Copyright 2026 Aaron Kimball
+// This library is licensed under the terms of the BSD 3-Clause license.
+// See the accompanying LICENSE.txt file for full license text.
+//
+// Access to I2C parallel bus expanders shared between ISRs, RTOS tasks and
+// CPU cores.
+
+#ifndef I2C_PARALLEL_SHARED_H
+#define I2C_PARALLEL_SHARED_H
+
+#include "I2CParallel2.h"
+
+// I2CParallelAtomic8 uses a critical section with interrupts disabled where
+// std::atomic is unavailable. This is only safe on single-core MCUs; define it
+// before including this header to use it on other such targets.
+#if defined(__AVR__) && !defined(I2C_PARALLEL_ATOMIC_CRITICAL_SECTION)
+#define I2C_PARALLEL_ATOMIC_CRITICAL_SECTION
+#endif
+
+#if !defined(I2C_PARALLEL_ATOMIC_CRITICAL_SECTION)
+#include <atomic>
+#endif
+
+// Devices that can be registered with one I2CParallelBusLock.
+static constexpr uint8_t I2C_PARALLEL_SHARED_MAX_DEVICES = 16;
+
+/**
+ * A byte updated atomically with respect to ISRs and other cores. With
+ * I2C_PARALLEL_ATOMIC_CRITICAL_SECTION (AVR) this is a critical section with
+ * interrupts disabled; elsewhere it is std::atomic.
+ */
+class I2CParallelAtomic8 {
+public:
+  explicit I2CParallelAtomic8(const uint8_t val = 0) : _val(val){};
+
+#if defined(I2C_PARALLEL_ATOMIC_CRITICAL_SECTION)
+  uint8_t load() const { return _val; };
+  void store(const uint8_t val) { _val = val; };
+  // If the value is `expected`, replace it with `desired` and return true;
+  // otherwise load the current value into `expected` and return false.
+  bool compareExchange(uint8_t& expected, const uint8_t desired) {
+#if defined(__AVR__)
+    const uint8_t sreg = SREG; // Restore, rather than enable, interrupts below.
+#endif
+    noInterrupts();
+    const bool swapped = _val == expected;
+    if (swapped) {
+      _val = desired;
+    } else {
+      expected = _val;
+    }
+#if defined(__AVR__)
+    SREG = sreg;
+#else
+    interrupts();
+#endif
+    return swapped;
+  };
+  // As compareExchange(), but may also fail spuriously on other cores
+  // (LL/SC). Only use it in a retry loop.
+  bool compareExchangeWeak(uint8_t& expected, const uint8_t desired) {
+    return compareExchange(expected, desired);
+  };
+
+private:
+  volatile uint8_t _val;
+#else
+  uint8_t load() const { return _val.load(); };
+  void store(const uint8_t val) { _val.store(val); };
+  bool compareExchange(uint8_t& expected, const uint8_t desired) {
+    return _val.compare_exchange_strong(expected, desired);
+  };
+  bool compareExchangeWeak(uint8_t& expected, const uint8_t desired) {
+    return _val.compare_exchange_weak(expected, desired);
+  };
+
+private:
+  std::atomic<uint8_t> _val;
+#endif
+};
+
+class I2CParallelShared;
+
+/**
+ * Serializes the bus traffic of every I2CParallelShared device on one I2C
+ * controller. Whoever holds the lock is the bus owner: before releasing it, the
+ * owner writes the pending output of every registered device, so callers that
+ * find the bus busy can return at once and leave their update to the owner.
+ */
+class I2CParallelBusLock {
+public:
+  I2CParallelBusLock() : _locked(0), _numDevices(0), _writes(0){};
+  ~I2CParallelBusLock(){};
+
+  // Take the lock if it is free. Returns false only if another context holds
+  // it: callers rely on that owner to write their update.
+  bool tryLock() {
+    uint8_t expected = 0;
+    return _locked.compareExchange(expected, 1);
+  };
+  // Take the lock, calling yield() while another context holds it. Never call
+  // this from an ISR.
+  void lock();
+  void unlock() { _locked.store(0); };
+
+  // Number of output writes performed by bus owners. Takes the lock to read
+  // the count, so never call this from an ISR or while holding the lock.
+  uint32_t getWriteCount();
+
+private:
+  bool add(I2CParallelShared* dev);
+  // Write every device's pending output. The lock must be held. Returns false
+  // if a write failed.
+  bool writePending();
+  bool anyPending() const;
+
+  I2CParallelAtomic8 _locked;
+  I2CParallelShared* _devices[I2C_PARALLEL_SHARED_MAX_DEVICES];
+  uint8_t _numDevices;
+  uint32_t _writes; // Only accessed by the owner.
+
+  friend class I2CParallelShared;
+};
+
+/**
+ * Thread-, ISR- and multicore-safe front end for one device.
+ *
+ * The output state lives in an atomic "target" byte. setOr(), setBit() etc.
+ * update it with a compare-and-swap loop, so concurrent read-modify-writes
+ * from different contexts are never lost, then try to become the bus owner to
+ * write it out. If the bus is busy, the call returns at once: the current
+ * owner writes the new target before releasing the bus. Updates that arrive
+ * while a write is in flight are therefore combined into the next single
+ * write.
+ *
+ * The post*() methods only update the target, without touching the bus; use
+ * them from ISRs (where Wire must not be used), and call flush() or any other
+ * method from a task to write. getByte() waits for the bus.
+ *
+ * All access to the device (and every other device on the same controller)
+ * must go through I2CParallelShared objects sharing one I2CParallelBusLock.
+ */
+class I2CParallelShared {
+public:
+  I2CParallelShared(I2CParallel& dev, I2CParallelBusLock& lock);
+  ~I2CParallelShared(){};
+
+  // Update the target output state without bus I/O. Safe from ISRs.
+  void postByte(const uint8_t val) { _target.store(val); };
+  void postOr(const uint8_t val);
+  void postAnd(const uint8_t val);
+  void postXor(const uint8_t val);
+
+  // Update the target and write it, or leave it to the current bus owner.
+  // Returns true if the target has been written (by this call or an earlier
+  // one), false if it was left to another context or a write failed.
+  bool setByte(const uint8_t val);
+  bool setOr(const uint8_t val);
+  bool setAnd(const uint8_t val);
+  bool setXor(const uint8_t val);
+  bool setBit(const uint8_t bitPos);
+  bool clrBit(const uint8_t bitPos);
+  bool toggleBit(const uint8_t bitPos);
+
+  // Write any pending output of the devices on this lock if the bus is free.
+  // Returns false if another context owns the bus (and will write it).
+  bool flush();
+
+  // Wait for the bus and read the device's inputs.
+  uint8_t getByte(uint8_t& nBytesRead);
+
+  // The target output state: what the pins will be once pending writes land.
+  uint8_t getTargetOutput() const { return _target.load(); };
+  // Return true if the target has not been written yet.
+  bool isPending() const { return _target.load() != _written.load(); };
+
+  I2CParallel& device() const { return _dev; };
+
+private:
+  // Write the target if it has changed. The bus lock must be held. Returns
+  // false if the write failed.
+  bool writePending();
+
+  I2CParallel& _dev;
+  I2CParallelBusLock& _lock;
+  I2CParallelAtomic8 _target;  // Output state requested by any context.
+  I2CParallelAtomic8 _written; // Output state last written by a bus owner.
+
+  friend class I2CParallelBusLock;
+};
+
+#endif /* I2C_PARALLEL_SHARED_H */
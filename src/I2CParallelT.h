@@ -0,0 +1,224 @@
+// (c) Copyright 2026 Aaron Kimball
+// This library is licensed under the terms of the BSD 3-Clause license.
+// See the accompanying LICENSE.txt file for full license text.
+//
+// Compile-time (non-virtual) drivers for I2C parallel bus expanders.
+//
+// I2CParallelT<Chip, Bus> is a header-only alternative to the I2CParallel
+// class hierarchy. The chip type is a template parameter, so there is no
+// vtable and every call can be inlined; the I2C controller can be any object
+// with the TwoWire interface (Wire, Wire1, a software I2C master, ...). Address
+// ranges and hold times are constexpr, so addresses given to init<Addr>() are
+// validated at compile time and waitForValid() folds to a constant delay.
+//
+// The I2CParallel8574 / 9534 / 9538 classes remain the full-featured drivers
+// (batching, burst I/O, statistics, interrupts); I2CParallelT covers the core
+// byte and bit I/O API for code size and speed sensitive applications. Both
+// speak to the chip through the same I2CParallelChip* protocol traits.
+
+#ifndef I2C_PARALLEL_T_H
+#define I2C_PARALLEL_T_H
+
+#include "I2CParallel2.h"
+
+/**
+ * The `io` transport of the I2CParallelChip* protocol code (see
+ * I2CParallel2.h) for a device at `addr` on the controller `bus`. Each call is
+ * a single attempt.
+ */
+template <typename Bus>
+class I2CParallelBusIo {
+public:
+  I2CParallelBusIo(Bus& bus, const uint8_t addr) : _bus(bus), _addr(addr){};
+
+  bool busWrite(const uint8_t* data, const uint8_t n, const bool sendStop, const uint8_t op) {
+    _bus.beginTransmission(_addr);
+    _bus.write(data, n);
+    return _bus.endTransmission(sendStop) == 0;
+  };
+  bool busRead(uint8_t& val, const bool sendStop, const uint8_t op) {
+    if (_bus.requestFrom(_addr, (uint8_t)1, (uint8_t)sendStop) != 1) {
+      return false;
+    }
+    val = _bus.read();
+    return true;
+  };
+
+private:
+  Bus& _bus;
+  const uint8_t _addr;
+};
+
+/**
+ * Non-virtual driver for one bus expander of type `Chip` on the I2C controller
+ * type `Bus`. The INT_L interrupt errata workaround is not applied: the
+ * register pointer of a '9534 stays on the INPUT register between reads. Use
+ * I2CParallel9534 if you need INT_L.
+ */
+template <typename Chip, typename Bus = TwoWire>
+class I2CParallelT {
+public:
+  explicit I2CParallelT(Bus& bus)
+      : _bus(bus), _outputState(I2C_PARALLEL_STARTUP_INPUT_STATE),
+        _inputState(I2C_PARALLEL_STARTUP_INPUT_STATE),
+        _configState(I2C_PARALLEL_STARTUP_INPUT_STATE), _polarityState(0),
+        _i2cAddr(UNINITIALIZED_I2C_ADDR), _error(I2C_PARALLEL_ERR_OK),
+        _regPointer(Chip::REG_POINTER_UNKNOWN), _outputValid(false){};
+
+  // Configure the device at a fixed address; invalid addresses fail to compile.
+  template <uint8_t i2cAddr>
+  void init(const uint32_t busSpeed = I2C_PARALLEL_MAX_BUS_SPEED) {
+    static_assert(Chip::isValidAddress(i2cAddr), "Invalid I2C address for this chip");
+    _error = I2C_PARALLEL_ERR_OK;
+    initAddr(i2cAddr, busSpeed);
+  };
+
+  // Configure the device at an address chosen at runtime. Unlike
+  // I2CParallel::init(), this only sets the bus clock; configure any bus
+  // timeout on the controller directly.
+  void init(const uint8_t i2cAddr, const uint32_t busSpeed = I2C_PARALLEL_MAX_BUS_SPEED) {
+    _error = I2C_PARALLEL_ERR_OK;
+    if (!Chip::isValidAddress(i2cAddr)) {
+      _error = I2C_PARALLEL_ERR_ADDR;
+    }
+    initAddr(i2cAddr, busSpeed);
+  };
+
+  // See I2CParallel::setByte().
+  size_t setByte(const uint8_t val) {
+    if (_i2cAddr == UNINITIALIZED_I2C_ADDR) {
+      _error = I2C_PARALLEL_ERR_UNINITIALIZED;
+      _outputState = val;
+      return 0;
+    } else if (_outputValid && val == _outputState) {
+      return 1;
+    }
+    _outputState = val;
+    _outputValid = Chip::writeOutput(io(), val, _regPointer);
+    if (!_outputValid) {
+      _error = I2C_PARALLEL_ERR_BUS_IO;
+      return 0;
+    }
+    return 1;
+  };
+  size_t write(const uint8_t val) { return setByte(val); };
+
+  // See I2CParallel::getByte().
+  uint8_t getByte(uint8_t& nBytesRead) {
+    nBytesRead = 0;
+    if (_i2cAddr == UNINITIALIZED_I2C_ADDR) {
+      _error = I2C_PARALLEL_ERR_UNINITIALIZED;
+    } else if (Chip::readInput(io(), _inputState, _regPointer)) {
+      nBytesRead = 1;
+    } else {
+      _error = I2C_PARALLEL_ERR_BUS_IO;
+    }
+    return _inputState;
+  };
+  uint8_t getByte() {
+    uint8_t numReceived = 0;
+    return getByte(numReceived);
+  };
+  uint8_t read() { return getByte(); };
+
+  uint8_t getLastInputState() const { return _inputState; };
+  uint8_t getLastOutputState() const { return _outputState; };
+
+  // See I2CParallel::enableInputs().
+  void enableInputs(const uint8_t mask) {
+    if (!Chip::HAS_REGISTERS) {
+      // Quasi-bidirectional I/O: set the specified bits high to enable inputs.
+      setOr(mask);
+      return;
+    } else if (_i2cAddr == UNINITIALIZED_I2C_ADDR) {
+      _error = I2C_PARALLEL_ERR_UNINITIALIZED;
+      return;
+    }
+    _configState = mask;
+    if (!Chip::writeRegister(io(), I2C_PCA9534_REG_CONFIG, mask, _regPointer)) {
+      _error = I2C_PARALLEL_ERR_BUS_IO;
+    }
+  };
+
+  // See I2CParallel9534::setInputPolarity().
+  void setInputPolarity(const uint8_t polarity) {
+    static_assert(Chip::HAS_REGISTERS, "This chip has no polarity register");
+    _polarityState = polarity;
+    if (_i2cAddr == UNINITIALIZED_I2C_ADDR) {
+      _error = I2C_PARALLEL_ERR_UNINITIALIZED;
+      return;
+    }
+    if (!Chip::writeRegister(io(), I2C_PCA9534_REG_POLARITY, polarity, _regPointer)) {
+      _error = I2C_PARALLEL_ERR_BUS_IO;
+    }
+  };
+
+  // Pulse RESET_L (wired to `resetPin`) and return to power-on state.
+  void reset(const uint8_t resetPin) {
+    static_assert(Chip::HAS_RESET, "This chip has no RESET_L pin");
+    pinMode(resetPin, OUTPUT);
+    digitalWrite(resetPin, LOW);
+    delayMicroseconds(1);
+    digitalWrite(resetPin, HIGH);
+    _inputState = I2C_PARALLEL_STARTUP_INPUT_STATE;
+    _outputState = I2C_PARALLEL_STARTUP_INPUT_STATE;
+    _configState = I2C_PARALLEL_STARTUP_INPUT_STATE;
+    _polarityState = 0;
+    _regPointer = Chip::REG_POINTER_UNKNOWN;
+    _outputValid = true;
+  };
+
+  size_t setOr(const uint8_t val) { return setByte(_outputState | val); };
+  size_t setAnd(const uint8_t val) { return setByte(_outputState & val); };
+  size_t setXor(const uint8_t val) { return setByte(_outputState ^ val); };
+
+  size_t setBit(const uint8_t bitPos) {
+    return bitPos > I2C_MAX_BIT_POS ? 0 : setOr((uint8_t)(1 << bitPos));
+  };
+  size_t clrBit(const uint8_t bitPos) {
+    return bitPos > I2C_MAX_BIT_POS ? 0 : setAnd((uint8_t)~(1 << bitPos));
+  };
+  size_t toggleBit(const uint8_t bitPos) {
+    return bitPos > I2C_MAX_BIT_POS ? 0 : setXor((uint8_t)(1 << bitPos));
+  };
+
+  size_t increment() {
+    if (_outputState == I2C_PARALLEL_MAX_VAL) {
+      _error = I2C_PARALLEL_ERR_CARRY;
+    }
+    return setByte(_outputState + 1);
+  };
+
+  // Delay for the chip's constant output-valid / input-hold time.
+  void waitForValid() const { delayMicroseconds((Chip::HOLD_NANOS + 999) / 1000); };
+
+  void clearError() { _error = I2C_PARALLEL_ERR_OK; };
+  uint8_t getError() const { return _error; };
+  bool hasError() const { return _error != I2C_PARALLEL_ERR_OK; };
+  uint8_t getAddress() const { return _i2cAddr; };
+
+private:
+  I2CParallelBusIo<Bus> io() { return I2CParallelBusIo<Bus>(_bus, _i2cAddr); };
+
+  void initAddr(const uint8_t i2cAddr, const uint32_t busSpeed) {
+    _i2cAddr = i2cAddr;
+    if (busSpeed > I2C_PARALLEL_MAX_BUS_SPEED) {
+      _error = I2C_PARALLEL_ERR_BUS_SPEED;
+    }
+    _regPointer = Chip::REG_POINTER_UNKNOWN;
+    _outputValid = false;
+    _bus.setClock(busSpeed);
+  };
+
+  Bus& _bus;
+  uint8_t _outputState;
+  uint8_t _inputState;
+  uint8_t _configState;
+  uint8_t _polarityState;
+  uint8_t _i2cAddr;
+  uint8_t _error;
+  uint8_t _regPointer;
+  bool _outputValid;
+};
+
+#endif /* I2C_PARALLEL_T_H */
@@ -0,0 +1,256 @@
+// (c) Copyright 2026 Aaron Kimball
+// This library is licensed under the terms of the BSD 3-Clause license.
+// See the accompanying LICENSE.txt file for full license text.
+//
+// TCAL6408 Implementation
+// See datasheet: https://www.ti.com/lit/ds/symlink/tcal6408.pdf
+//
+// To use, include I2CParallel2.h, and instantiate an I2CParallelTCAL6408 object.
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <cstdint>
+
+#include "I2CParallel2.h"
+
+// Register addresses for the command byte to send to the device.
+static constexpr uint8_t REG_INPUT = I2C_PCA9534_REG_INPUT;
+static constexpr uint8_t REG_DRIVE_0 = 0x40; // Drive strength, pins 0--3.
+static constexpr uint8_t REG_DRIVE_1 = 0x41; // Drive strength, pins 4--7.
+static constexpr uint8_t REG_INPUT_LATCH = 0x42;
+static constexpr uint8_t REG_PULL_ENABLE = 0x43;
+static constexpr uint8_t REG_PULL_SELECT = 0x44;
+static constexpr uint8_t REG_INT_MASK = 0x45;
+static constexpr uint8_t REG_INT_STATUS = 0x46;
+static constexpr uint8_t REG_OUTPUT_CONFIG = 0x4F;
+
+static constexpr uint8_t OUTPUT_CONFIG_OPEN_DRAIN = 0x01;
+
+// Each pin's drive strength is a 2-bit field.
+static constexpr uint8_t DRIVE_BITS_PER_PIN = 2;
+static constexpr uint8_t DRIVE_FIELD_MASK = 0x03;
+
+void I2CParallelTCAL6408::init(const uint8_t i2cAddr, const uint32_t busSpeed) {
+  I2CParallel9538::init(i2cAddr, busSpeed);
+
+  if (_i2cAddr < I2C_TCAL6408_MIN_ADDR || _i2cAddr > I2C_TCAL6408_MAX_ADDR) {
+    _error = I2C_PARALLEL_ERR_ADDR;
+  }
+}
+
+void I2CParallelTCAL6408::writeShadowed(
+    const uint8_t reg, const uint8_t shadow, uint8_t& cached, const uint8_t val) {
+  if (_i2cAddr == UNINITIALIZED_I2C_ADDR) {
+    cached = val;
+    _error = I2C_PARALLEL_ERR_UNINITIALIZED;
+    return;
+  }
+
+  if (isShadowValid(shadow) && val == cached) {
+    return; // The register already holds this value.
+  }
+
+  cached = val;
+  if (writeRegister(reg, val)) {
+    _shadowValid |= shadow;
+  } else {
+    _shadowValid &= ~shadow;
+  }
+}
+
+void I2CParallelTCAL6408::setInputLatch(const uint8_t mask) {
+  writeShadowed(REG_INPUT_LATCH, SHADOW_INPUT_LATCH, _inputLatchState, mask);
+}
+
+void I2CParallelTCAL6408::setInterruptMask(const uint8_t mask) {
+  writeShadowed(REG_INT_MASK, SHADOW_INT_MASK, _intMaskState, mask);
+}
+
+void I2CParallelTCAL6408::setOpenDrain(const bool openDrain) {
+  writeShadowed(REG_OUTPUT_CONFIG, SHADOW_OUTPUT_CONFIG, _outputConfigState,
+      openDrain ? OUTPUT_CONFIG_OPEN_DRAIN : 0);
+}
+
+void I2CParallelTCAL6408::setPullResistors(const uint8_t enableMask, const uint8_t pullUpMask) {
+  if (_i2cAddr == UNINITIALIZED_I2C_ADDR) {
+    _pullEnableState = enableMask;
+    _pullSelectState = pullUpMask;
+    _error = I2C_PARALLEL_ERR_UNINITIALIZED;
+    return;
+  }
+
+  const bool valid = isShadowValid(SHADOW_PULL);
+  if (valid && enableMask == _pullEnableState && pullUpMask == _pullSelectState) {
+    return;
+  }
+
+  // Select the direction before enabling, so a newly-enabled resistor never
+  // pulls the wrong way, even briefly.
+  bool ok = true;
+  if (!valid || pullUpMask != _pullSelectState) {
+    _pullSelectState = pullUpMask;
+    ok = writeRegister(REG_PULL_SELECT, pullUpMask);
+  }
+  if (ok && (!valid || enableMask != _pullEnableState)) {
+    _pullEnableState = enableMask;
+    ok = writeRegister(REG_PULL_ENABLE, enableMask);
+  }
+
+  if (ok) {
+    _shadowValid |= SHADOW_PULL;
+  } else {
+    _pullEnableState = enableMask;
+    _shadowValid &= ~SHADOW_PULL;
+  }
+}
+
+void I2CParallelTCAL6408::setDriveStrengths(const uint16_t strengths) {
+  if (_i2cAddr == UNINITIALIZED_I2C_ADDR) {
+    _driveState = strengths;
+    _error = I2C_PARALLEL_ERR_UNINITIALIZED;
+    return;
+  }
+
+  const bool valid = isShadowValid(SHADOW_DRIVE);
+  const uint8_t low = strengths & 0xFF;
+  const uint8_t high = strengths >> 8;
+  bool ok = true;
+  // Only write the half (pins 0--3 or 4--7) that changed.
+  if (!valid || low != (_driveState & 0xFF)) {
+    ok = writeRegister(REG_DRIVE_0, low);
+  }
+  if (ok && (!valid || high != (_driveState >> 8))) {
+    ok = writeRegister(REG_DRIVE_1, high);
+  }
+
+  _driveState = strengths;
+  if (ok) {
+    _shadowValid |= SHADOW_DRIVE;
+  } else {
+    _shadowValid &= ~SHADOW_DRIVE;
+  }
+}
+
+void I2CParallelTCAL6408::setDriveStrength(const uint8_t pin, const uint8_t strength) {
+  if (pin > I2C_MAX_BIT_POS) {
+    return;
+  }
+  const uint8_t shift = pin * DRIVE_BITS_PER_PIN;
+  const uint16_t field = (uint16_t)DRIVE_FIELD_MASK << shift;
+  setDriveStrengths((_driveState & ~field) | (((uint16_t)strength << shift) & field));
+}
+
+uint8_t I2CParallelTCAL6408::getInterruptStatus() {
+  if (_i2cAddr == UNINITIALIZED_I2C_ADDR) {
+    _error = I2C_PARALLEL_ERR_UNINITIALIZED;
+    return 0;
+  }
+
+  uint8_t status = 0;
+  readRegister(REG_INT_STATUS, status);
+  return status;
+}
+
+uint8_t I2CParallelTCAL6408::getChangedPins() {
+  if (_i2cAddr == UNINITIALIZED_I2C_ADDR) {
+    _error = I2C_PARALLEL_ERR_UNINITIALIZED;
+    return 0;
+  }
+
+  // Reading INPUT clears the status register, so read the status first. Hold
+  // the bus with a repeated START between the two reads: one transaction total.
+  uint8_t status;
+  if (!readRegister(REG_INT_STATUS, status, false)) {
+    return 0;
+  }
+
+  uint8_t val;
+  if (!readRegister(REG_INPUT, val)) {
+    return 0;
+  }
+  _inputState = val;
+  return status;
+}
+
+void I2CParallelTCAL6408::reset() {
+  I2CParallel9538::reset();
+  if (_resetPin == INVALID_GPIO_PIN || _restoreOnReset) {
+    return;
+  }
+
+  _driveState = DRIVE_POWER_ON;
+  _inputLatchState = 0;
+  _pullEnableState = 0;
+  _pullSelectState = I2C_PARALLEL_MAX_VAL;
+  _intMaskState = I2C_PARALLEL_MAX_VAL;
+  _outputConfigState = 0;
+  _shadowValid |= SHADOW_DRIVE | SHADOW_INPUT_LATCH | SHADOW_PULL | SHADOW_INT_MASK
+      | SHADOW_OUTPUT_CONFIG;
+}
+
+uint8_t I2CParallelTCAL6408::addRestoreWrites(RegisterWrite* writes, uint8_t n) {
+  // Output drive and pull settings go in before CONFIG enables any outputs.
+  if ((_driveState & 0xFF) != (DRIVE_POWER_ON & 0xFF)) {
+    writes[n++] = { REG_DRIVE_0, (uint8_t)(_driveState & 0xFF) };
+  }
+  if ((_driveState >> 8) != (DRIVE_POWER_ON >> 8)) {
+    writes[n++] = { REG_DRIVE_1, (uint8_t)(_driveState >> 8) };
+  }
+  if (_outputConfigState != 0) {
+    writes[n++] = { REG_OUTPUT_CONFIG, _outputConfigState };
+  }
+  if (_pullSelectState != I2C_PARALLEL_MAX_VAL) {
+    writes[n++] = { REG_PULL_SELECT, _pullSelectState };
+  }
+  if (_pullEnableState != 0) {
+    writes[n++] = { REG_PULL_ENABLE, _pullEnableState };
+  }
+  if (_inputLatchState != 0) {
+    writes[n++] = { REG_INPUT_LATCH, _inputLatchState };
+  }
+  if (_intMaskState != I2C_PARALLEL_MAX_VAL) {
+    writes[n++] = { REG_INT_MASK, _intMaskState };
+  }
+  return n;
+}
+
+bool I2CParallelTCAL6408::restore() {
+  if (!I2CParallel9534::restore()) {
+    return false;
+  }
+  _shadowValid |= SHADOW_DRIVE | SHADOW_INPUT_LATCH | SHADOW_PULL | SHADOW_INT_MASK
+      | SHADOW_OUTPUT_CONFIG;
+  return true;
+}
+
+bool I2CParallelTCAL6408::resync() {
+  if (!I2CParallel9534::resync()) {
+    return false;
+  }
+
+  uint8_t low;
+  uint8_t high;
+  if (!readRegister(REG_DRIVE_0, low) || !readRegister(REG_DRIVE_1, high)) {
+    return false;
+  }
+  _driveState = ((uint16_t)high << 8) | low;
+  _shadowValid |= SHADOW_DRIVE;
+  if (!readRegister(REG_INPUT_LATCH, _inputLatchState)) {
+    return false;
+  }
+  _shadowValid |= SHADOW_INPUT_LATCH;
+  if (!readRegister(REG_PULL_ENABLE, _pullEnableState)
+      || !readRegister(REG_PULL_SELECT, _pullSelectState)) {
+    return false;
+  }
+  _shadowValid |= SHADOW_PULL;
+  if (!readRegister(REG_INT_MASK, _intMaskState)) {
+    return false;
+  }
+  _shadowValid |= SHADOW_INT_MASK;
+  if (!readRegister(REG_OUTPUT_CONFIG, _outputConfigState)) {
+    return false;
+  }
+  _shadowValid |= SHADOW_OUTPUT_CONFIG;
+  return true;
+}
@@ -0,0 +1,169 @@
+// (c) Copyright 2026 Aaron Kimball
+// This library is licensed under the terms of the BSD 3-Clause license.
+// See the accompanying LICENSE.txt file for full license text.
+//
+// I2CParallelWaveform Implementation
+//
+// To use, include I2CParallelWaveform.h, construct an I2CParallelWaveform over
+// an init()'ed device, describe the pins, compile(), and play() from loop().
+
+#include <Arduino.h>
+#include <cstdint>
+
+#include "I2CParallelWaveform.h"
+
+// Segment boundaries in one period: tick 0 plus every edge of every pin.
+static constexpr uint8_t MAX_BOUNDARIES =
+    1 + (I2C_MAX_BIT_POS + 1) * I2C_PARALLEL_WAVEFORM_MAX_EDGES;
+
+static constexpr uint16_t MAX_REPEAT = 255; // setBytes() takes a uint8_t repeat count.
+
+static uint16_t gcd(uint16_t a, uint16_t b) {
+  while (b != 0) {
+    const uint16_t t = a % b;
+    a = b;
+    b = t;
+  }
+  return a;
+}
+
+I2CParallelWaveform::I2CParallelWaveform(I2CParallel& dev, const uint16_t periodTicks)
+    : _dev(dev), _periodTicks(periodTicks), _pinMask(0), _initialHigh(0), _numSteps(0),
+      _repeat(1) {
+  for (uint8_t pin = 0; pin <= I2C_MAX_BIT_POS; pin++) {
+    _numEdges[pin] = 0;
+  }
+}
+
+void I2CParallelWaveform::setDuty(const uint8_t pin, const uint16_t highTicks) {
+  if (highTicks == 0 || highTicks >= _periodTicks) {
+    setTimeline(pin, highTicks != 0, nullptr, 0);
+  } else {
+    setTimeline(pin, true, &highTicks, 1);
+  }
+}
+
+bool I2CParallelWaveform::setTimeline(
+    const uint8_t pin, const bool initialHigh, const uint16_t* edges, const uint8_t n) {
+  if (pin > I2C_MAX_BIT_POS || n > I2C_PARALLEL_WAVEFORM_MAX_EDGES) {
+    return false;
+  }
+  const uint8_t bit = 1 << pin;
+  _pinMask |= bit;
+  _initialHigh = initialHigh ? (_initialHigh | bit) : (_initialHigh & ~bit);
+  uint8_t numEdges = 0;
+  for (uint8_t i = 0; i < n; i++) {
+    if (edges[i] < _periodTicks) {
+      _edges[pin][numEdges++] = edges[i];
+    }
+  }
+  _numEdges[pin] = numEdges;
+  return true;
+}
+
+void I2CParallelWaveform::clearPin(const uint8_t pin) {
+  if (pin > I2C_MAX_BIT_POS) {
+    return;
+  }
+  _pinMask &= ~(1 << pin);
+  _numEdges[pin] = 0;
+}
+
+bool I2CParallelWaveform::levelAt(const uint8_t pin, const uint16_t t) const {
+  bool high = (_initialHigh >> pin) & 1;
+  for (uint8_t i = 0; i < _numEdges[pin] && _edges[pin][i] <= t; i++) {
+    high = !high;
+  }
+  return high;
+}
+
+bool I2CParallelWaveform::compile() {
+  _numSteps = 0;
+  if (_periodTicks == 0) {
+    return false;
+  }
+
+  // Sorted, distinct segment start times.
+  uint16_t starts[MAX_BOUNDARIES];
+  uint8_t numStarts = 1;
+  starts[0] = 0;
+  for (uint8_t pin = 0; pin <= I2C_MAX_BIT_POS; pin++) {
+    if ((_pinMask & (1 << pin)) == 0) {
+      continue;
+    }
+    for (uint8_t i = 0; i < _numEdges[pin]; i++) {
+      const uint16_t t = _edges[pin][i];
+      uint8_t pos = numStarts;
+      while (pos > 0 && starts[pos - 1] > t) {
+        pos--;
+      }
+      if (pos > 0 && starts[pos - 1] == t) {
+        continue;
+      }
+      for (uint8_t j = numStarts; j > pos; j--) {
+        starts[j] = starts[j - 1];
+      }
+      starts[pos] = t;
+      numStarts++;
+    }
+  }
+
+  // The output byte of each segment; merge neighbors that come out equal.
+  const uint8_t fixed = _dev.getLastOutputState() & ~_pinMask;
+  uint8_t vals[MAX_BOUNDARIES];
+  uint8_t numSegments = 0;
+  for (uint8_t s = 0; s < numStarts; s++) {
+    uint8_t val = fixed;
+    for (uint8_t pin = 0; pin <= I2C_MAX_BIT_POS; pin++) {
+      if ((_pinMask & (1 << pin)) != 0 && levelAt(pin, starts[s])) {
+        val |= 1 << pin;
+      }
+    }
+    if (numSegments > 0 && vals[numSegments - 1] == val) {
+      continue;
+    }
+    vals[numSegments] = val;
+    starts[numSegments] = starts[s];
+    numSegments++;
+  }
+
+  // Every segment is a whole number of `repeat`-tick steps.
+  uint16_t step = _periodTicks;
+  for (uint8_t s = 1; s < numSegments; s++) {
+    step = gcd(step, starts[s]);
+  }
+  // A divisor of `step` still divides every segment.
+  for (uint16_t d = step; step > MAX_REPEAT; d--) {
+    if (step % d == 0 && d <= MAX_REPEAT) {
+      step = d;
+    }
+  }
+  if (_periodTicks / step > I2C_PARALLEL_WAVEFORM_MAX_STEPS) {
+    return false;
+  }
+
+  uint8_t numSteps = 0;
+  for (uint8_t s = 0; s < numSegments; s++) {
+    const uint16_t end = (s + 1 < numSegments) ? starts[s + 1] : _periodTicks;
+    for (uint16_t t = starts[s]; t < end; t += step) {
+      _steps[numSteps++] = vals[s];
+    }
+  }
+  _numSteps = numSteps;
+  _repeat = step;
+  return true;
+}
+
+uint16_t I2CParallelWaveform::play(const uint16_t periods) {
+  if (_numSteps == 0) {
+    return 0;
+  }
+  uint16_t numPlayed = 0;
+  for (uint16_t p = 0; p < periods; p++) {
+    if (_dev.setBytes(_steps, _numSteps, _repeat) != _numSteps) {
+      break;
+    }
+    numPlayed++;
+  }
+  return numPlayed;
+}
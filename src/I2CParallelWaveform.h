@@ -0,0 +1,91 @@
+// (c) Copyright 2026 Aaron Kimball
+// This library is licensed under the terms of the BSD 3-Clause license.
+// See the accompanying LICENSE.txt file for full license text.
+//
+// Software PWM and pin waveforms played through burst writes.
+
+#ifndef I2C_PARALLEL_WAVEFORM_H
+#define I2C_PARALLEL_WAVEFORM_H
+
+#include "I2CParallel2.h"
+
+// Longest compiled period, in output bytes handed to setBytes().
+static constexpr uint8_t I2C_PARALLEL_WAVEFORM_MAX_STEPS = 64;
+
+// Edges per pin per period for setTimeline().
+static constexpr uint8_t I2C_PARALLEL_WAVEFORM_MAX_EDGES = 8;
+
+/**
+ * Plays a periodic waveform on the pins of one device with setBytes().
+ *
+ * Time is measured in ticks of one bus byte-time (9 SCL periods: 22.5us at
+ * 400 kHz), the time each data byte of a burst write holds the pins. Describe
+ * each pin with setDuty() (high for the first `highTicks` of the period) or
+ * setTimeline() (a list of edge times), then compile(): the edges of all pins
+ * are merged into one sorted sequence of output bytes, and segment lengths are
+ * factored into setBytes()' `repeat` count where possible. play() then writes
+ * one period per burst, so 8 PWM channels cost one write per period rather
+ * than one per edge.
+ *
+ * Edges inside a period are exact to the tick. Between periods the pins hold
+ * the last byte for the burst's START / address (and on a '9534, command)
+ * overhead plus whatever the caller does before the next play(). A period is
+ * one I2C transaction as long as its bytes fit the Wire TX buffer (32 on AVR).
+ * Pins not given a waveform keep the device's output state at compile().
+ */
+class I2CParallelWaveform {
+public:
+  I2CParallelWaveform(I2CParallel& dev, const uint16_t periodTicks);
+  ~I2CParallelWaveform(){};
+
+  // Duration of one tick (9 SCL periods) at `busSpeed`, in nanoseconds. Split
+  // as 9 * (1e9 / busSpeed) plus the scaled remainder, so it needs only 32-bit
+  // division; the result is the same as 9e9 / busSpeed.
+  static uint32_t tickNanos(const uint32_t busSpeed) {
+    return 9 * (1000000000UL / busSpeed) + 9 * (1000000000UL % busSpeed) / busSpeed;
+  };
+
+  uint16_t getPeriodTicks() const { return _periodTicks; };
+
+  // Drive `pin` high for the first `highTicks` of each period, then low.
+  void setDuty(const uint8_t pin, const uint16_t highTicks);
+
+  // Drive `pin` at `initialHigh` from the start of each period, toggling at
+  // each of the `n` (ascending) tick offsets in `edges`. Returns false if n is
+  // over I2C_PARALLEL_WAVEFORM_MAX_EDGES.
+  bool setTimeline(
+      const uint8_t pin, const bool initialHigh, const uint16_t* edges, const uint8_t n);
+
+  // Stop driving `pin` from the waveform.
+  void clearPin(const uint8_t pin);
+
+  // Merge the pin timelines into a sequence of output bytes. Returns false if
+  // the period needs more than I2C_PARALLEL_WAVEFORM_MAX_STEPS bytes.
+  bool compile();
+
+  // Write `periods` periods of the compiled waveform, one burst each. Returns
+  // the number of periods fully written.
+  uint16_t play(const uint16_t periods = 1);
+
+  // The compiled sequence: getNumSteps() bytes, each held getRepeat() ticks.
+  uint8_t getNumSteps() const { return _numSteps; };
+  uint8_t getRepeat() const { return _repeat; };
+  const uint8_t* getSteps() const { return _steps; };
+
+private:
+  // Level of `pin` at tick `t` of the period.
+  bool levelAt(const uint8_t pin, const uint16_t t) const;
+
+  I2CParallel& _dev;
+  uint16_t _periodTicks;
+  uint8_t _pinMask;     // Pins driven by the waveform.
+  uint8_t _initialHigh; // Level of each pin at tick 0.
+  uint16_t _edges[I2C_MAX_BIT_POS + 1][I2C_PARALLEL_WAVEFORM_MAX_EDGES];
+  uint8_t _numEdges[I2C_MAX_BIT_POS + 1];
+
+  uint8_t _steps[I2C_PARALLEL_WAVEFORM_MAX_STEPS];
+  uint8_t _numSteps;
+  uint8_t _repeat;
+};
+
+#endif /* I2C_PARALLEL_WAVEFORM_H */